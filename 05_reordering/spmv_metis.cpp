@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cstdio>
 #include <map>
+#include "kernels.hpp" // spmv_csr (dijaga oleh 15_perf_regression)
 
 // STRUKTUR DATA UTAMA
 struct CSRMatrix {
@@ -83,23 +84,127 @@ CSRMatrix generate_3d_stencil_shuffled(int nx, int ny, int nz) {
     return mat;
 }
 
-// 2. FUNGSI BENCHMARK (Running SpMV on GPU/CPU)
-double benchmark_spmv(const CSRMatrix& h_mat, int repeat = 100) {
+// 2. MATRIKS DI DEVICE: PATTERN (TETAP) + VALUES (BERUBAH TIAP STEP)
+// Di time-stepping, pola sparsity tidak pernah berubah, hanya values.
+// Pattern handle menyimpan semua yang mahal dibuat ulang: row_map/col_idx yang SUDAH dipermutasi
+// dan value_map (posisi simpan k -> index values di matriks asli). View = handle ber-refcount,
+// jadi satu pattern bisa dipakai bersama banyak matriks.
+struct SpMVPattern {
+    Kokkos::View<int*> row_map;
+    Kokkos::View<int*> col_idx;
+    Kokkos::View<int*> value_map; // values(k) = original_values[value_map(k)]
+    int num_rows;
+    int num_nnz;
+};
+
+struct DeviceMatrix {
+    SpMVPattern pattern;
+    Kokkos::View<double*> values;           // Layout tersimpan (sudah dipermutasi)
+    Kokkos::View<double*> staging;          // Values urutan asli, buffer upload
+    Kokkos::View<double*> x;
+    Kokkos::View<double*> y;
+};
+
+// CSR polos tanpa value_map/staging: hasil jalur lama (upload_matrix), tidak bisa di-update_values.
+struct DeviceCSR {
+    Kokkos::View<int*>    row_map;
+    Kokkos::View<int*>    col_idx;
+    Kokkos::View<double*> values;
+    Kokkos::View<double*> x;
+    Kokkos::View<double*> y;
+    int num_rows;
+    int num_nnz;
+};
+
+// Bangun pattern sekali: permutasi simetris P * A * P^T (perm[old_row] = new_row_id),
+// tapi yang disimpan adalah ASAL tiap nnz, bukan nilainya.
+SpMVPattern build_pattern(const CSRMatrix& src, const std::vector<idx_t>& perm) {
+    int N = src.num_rows;
+    std::vector<int> iperm(N);
+    for(int i=0; i<N; i++) iperm[perm[i]] = i;
+
+    SpMVPattern pat;
+    pat.num_rows  = N;
+    pat.num_nnz   = src.num_nnz;
+    pat.row_map   = Kokkos::View<int*>("row_map", N + 1);
+    pat.col_idx   = Kokkos::View<int*>("col_idx", src.num_nnz);
+    pat.value_map = Kokkos::View<int*>("value_map", src.num_nnz);
+
+    auto h_row_map_v   = Kokkos::create_mirror_view(pat.row_map);
+    auto h_col_idx_v   = Kokkos::create_mirror_view(pat.col_idx);
+    auto h_value_map_v = Kokkos::create_mirror_view(pat.value_map);
+
+    int current_nnz = 0;
+    h_row_map_v(0) = 0;
+    std::vector<std::pair<int, int>> temp; // (new_col, old_k)
+    for (int new_row = 0; new_row < N; ++new_row) {
+        int old_row = iperm[new_row];
+        temp.clear();
+        for(int k=src.row_map[old_row]; k<src.row_map[old_row+1]; k++) {
+            temp.push_back({(int)perm[src.col_idx[k]], k});
+        }
+        std::sort(temp.begin(), temp.end());
+        for(auto& e : temp) {
+            h_col_idx_v(current_nnz)   = e.first;
+            h_value_map_v(current_nnz) = e.second;
+            current_nnz++;
+        }
+        h_row_map_v(new_row + 1) = current_nnz;
+    }
+
+    Kokkos::deep_copy(pat.row_map, h_row_map_v);
+    Kokkos::deep_copy(pat.col_idx, h_col_idx_v);
+    Kokkos::deep_copy(pat.value_map, h_value_map_v);
+    return pat;
+}
+
+// Value-only update: 1 copy values (urutan asli) + 1 gather di device ke layout tersimpan.
+// Tidak ada alokasi, permutasi, atau copy ulang row_map/col_idx.
+// std::vector dibungkus View Unmanaged (tanpa alokasi) -> deep_copy langsung ke device, tanpa loop host.
+void update_values(DeviceMatrix& A, const std::vector<double>& original_values) {
+    Kokkos::View<const double*, Kokkos::HostSpace, Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+        h_values(original_values.data(), A.pattern.num_nnz);
+    Kokkos::deep_copy(A.staging, h_values);
+
+    auto values    = A.values;
+    auto staging   = A.staging;
+    auto value_map = A.pattern.value_map;
+    Kokkos::parallel_for("Update_Values", A.pattern.num_nnz, KOKKOS_LAMBDA(const int k) {
+        values(k) = staging(value_map(k));
+    });
+}
+
+DeviceMatrix create_matrix(const SpMVPattern& pat, const std::vector<double>& original_values) {
+    DeviceMatrix A;
+    A.pattern   = pat;
+    A.values    = Kokkos::View<double*>("values", pat.num_nnz);
+    A.staging   = Kokkos::View<double*>("values_staging", pat.num_nnz);
+    A.x         = Kokkos::View<double*>("x", pat.num_rows);
+    A.y         = Kokkos::View<double*>("y", pat.num_rows);
+    Kokkos::deep_copy(A.x, 1.0);
+    update_values(A, original_values);
+    return A;
+}
+
+// Jalur lama (tanpa pattern): alokasi 5 View + mirror + deep_copy dari CSR yang sudah jadi.
+// Mengembalikan DeviceCSR polos -> perubahan values berarti membangun ulang matriks.
+DeviceCSR upload_matrix(const CSRMatrix& h_mat) {
     int N = h_mat.num_rows;
     int NNZ = h_mat.num_nnz;
 
-    // Move to Device
-    Kokkos::View<int*>      row_map("row_map", N + 1);
-    Kokkos::View<int*>      col_idx("col_idx", NNZ);
-    Kokkos::View<double*>   values("values", NNZ);
-    Kokkos::View<double*>   x("x", N);
-    Kokkos::View<double*>   y("y", N);
-    
-    // Create Mirrors & Deep Copy (Omitted for brevity, assuming standard way)
-    auto h_row_map_v = Kokkos::create_mirror_view(row_map);
-    auto h_col_idx_v = Kokkos::create_mirror_view(col_idx);
-    auto h_values_v  = Kokkos::create_mirror_view(values);
-    auto h_x_v       = Kokkos::create_mirror_view(x);
+    DeviceCSR A;
+    A.num_rows = N;
+    A.num_nnz  = NNZ;
+    A.row_map  = Kokkos::View<int*>("row_map", N + 1);
+    A.col_idx  = Kokkos::View<int*>("col_idx", NNZ);
+    A.values   = Kokkos::View<double*>("values", NNZ);
+    A.x        = Kokkos::View<double*>("x", N);
+    A.y        = Kokkos::View<double*>("y", N);
+
+    auto h_row_map_v = Kokkos::create_mirror_view(A.row_map);
+    auto h_col_idx_v = Kokkos::create_mirror_view(A.col_idx);
+    auto h_values_v  = Kokkos::create_mirror_view(A.values);
+    auto h_x_v       = Kokkos::create_mirror_view(A.x);
 
     for(int i=0; i<=N; i++) h_row_map_v(i) = h_mat.row_map[i];
     for(int i=0; i<NNZ; i++) {
@@ -108,25 +213,27 @@ double benchmark_spmv(const CSRMatrix& h_mat, int repeat = 100) {
     }
     for(int i=0; i<N; i++) h_x_v(i) = 1.0;
 
-    Kokkos::deep_copy(row_map, h_row_map_v);
-    Kokkos::deep_copy(col_idx, h_col_idx_v);
-    Kokkos::deep_copy(values, h_values_v);
-    Kokkos::deep_copy(x, h_x_v);
+    Kokkos::deep_copy(A.row_map, h_row_map_v);
+    Kokkos::deep_copy(A.col_idx, h_col_idx_v);
+    Kokkos::deep_copy(A.values, h_values_v);
+    Kokkos::deep_copy(A.x, h_x_v);
+    return A;
+}
+
+void spmv(const DeviceMatrix& A) {
+    spmv_csr(A.pattern.row_map, A.pattern.col_idx, A.values, A.x, A.y);
+}
 
+void spmv(const DeviceCSR& A) {
+    spmv_csr(A.row_map, A.col_idx, A.values, A.x, A.y);
+}
+
+// FUNGSI BENCHMARK (Running SpMV on GPU/CPU) -- semua View sudah resident di device
+template <class Matrix>
+double benchmark_spmv(const Matrix& A, int repeat = 100) {
     Kokkos::fence();
     Kokkos::Timer timer;
-    
-    for(int iter=0; iter<repeat; iter++) {
-        Kokkos::parallel_for("SpMV_Run", N, KOKKOS_LAMBDA(const int i) {
-            double sum = 0.0;
-            int start = row_map(i);
-            int end   = row_map(i+1);
-            for (int k = start; k < end; k++) {
-                sum += values(k) * x(col_idx(k));
-            }
-            y(i) = sum;
-        });
-    }
+    for(int iter=0; iter<repeat; iter++) spmv(A);
     Kokkos::fence();
     return timer.seconds() / repeat;
 }
@@ -194,7 +301,8 @@ int main(int argc, char* argv[]) {
     // A. Generate "Bad" Matrix (Shuffled Grid)
     printf("Generating Shuffled 3D Grid...\n");
     CSRMatrix mat_orig = generate_3d_stencil_shuffled(GRID_DIM, GRID_DIM, GRID_DIM);
-    double t_orig = benchmark_spmv(mat_orig);
+    DeviceCSR A_orig = upload_matrix(mat_orig);
+    double t_orig = benchmark_spmv(A_orig);
     printf("[Baseline] Original Time: %f s | %.2f GFLOPs\n", 
            t_orig, (2.0*mat_orig.num_nnz*1e-9)/t_orig);
 
@@ -208,8 +316,8 @@ int main(int argc, char* argv[]) {
     // Siapkan array METIS (harus tipe idx_t)
     std::vector<idx_t> xadj(mat_orig.row_map.begin(), mat_orig.row_map.end());
     std::vector<idx_t> adjncy(mat_orig.col_idx.begin(), mat_orig.col_idx.end());
-    std::vector<idx_t> perm(N);  // Output: New ID for each node
-    std::vector<idx_t> iperm(N); // Output: Old ID for each new position
+    std::vector<idx_t> perm(N);  // Output: Old ID for each new position (perm[new] = old)
+    std::vector<idx_t> iperm(N); // Output: New ID for each node (iperm[old] = new)
 
     idx_t options[METIS_NOPTIONS];
     METIS_SetDefaultOptions(options);
@@ -220,16 +328,50 @@ int main(int argc, char* argv[]) {
     if(status != METIS_OK) {
         printf("METIS Error! Code: %d\n", status);
     } else {
-        // C. Permute Matrix
-        CSRMatrix mat_opt = permute_matrix(mat_orig, perm);
+        // C. Permute Pattern (sekali saja)
+        // build_pattern/permute_matrix butuh peta old -> new, yaitu iperm dari METIS (bukan perm).
+        SpMVPattern pattern_opt = build_pattern(mat_orig, iperm);
+        DeviceMatrix A_opt = create_matrix(pattern_opt, mat_orig.values);
         
         // D. Benchmark Optimized Matrix
-        double t_opt = benchmark_spmv(mat_opt);
+        double t_opt = benchmark_spmv(A_opt);
         printf("[Optimized] METIS Time : %f s | %.2f GFLOPs\n", 
-               t_opt, (2.0*mat_opt.num_nnz*1e-9)/t_opt);
+               t_opt, (2.0*mat_orig.num_nnz*1e-9)/t_opt);
                
         double speedup = t_orig / t_opt;
         printf(">>> SPEEDUP: %.2fx <<<\n", speedup);
+
+        // E. Time-Stepping: pola tetap, values berubah tiap step.
+        // Full rebuild = permute_matrix + upload_matrix (alokasi & copy 5 View, jalur lama).
+        // Value-only   = update_values pada pattern yang resident.
+        // Kedua loop mengisi values baru dengan cara yang sama (di luar bagian yang dibandingkan).
+        const int STEPS = 10;
+        CSRMatrix mat_step = mat_orig; // Sekali, di luar timer: simulasi hanya values yang berubah
+        std::vector<double> step_values(mat_orig.values);
+        printf("Time-stepping %d steps (update + 1 SpMV per step)...\n", STEPS);
+
+        Kokkos::fence();
+        Kokkos::Timer step_timer;
+        for(int step=0; step<STEPS; step++) {
+            for(int k=0; k<mat_orig.num_nnz; k++) mat_step.values[k] = mat_orig.values[k] * (1.0 + 0.01*step);
+            DeviceCSR A_step = upload_matrix(permute_matrix(mat_step, iperm));
+            spmv(A_step);
+            Kokkos::fence();
+        }
+        double t_rebuild = step_timer.seconds() / STEPS;
+
+        step_timer.reset();
+        for(int step=0; step<STEPS; step++) {
+            for(int k=0; k<mat_orig.num_nnz; k++) step_values[k] = mat_orig.values[k] * (1.0 + 0.01*step);
+            update_values(A_opt, step_values);
+            spmv(A_opt);
+            Kokkos::fence();
+        }
+        double t_update = step_timer.seconds() / STEPS;
+
+        printf("[Full Rebuild] per step: %f s\n", t_rebuild);
+        printf("[Value Update] per step: %f s (SpMV alone: %f s)\n", t_update, t_opt);
+        printf(">>> UPDATE SPEEDUP: %.2fx <<<\n", t_rebuild / t_update);
     }
 
   }
@@ -1,6 +1,7 @@
 #include <Kokkos_Core.hpp>
 #include <cstdio>
 #include <vector>
+#include "spmv_team.hpp" // spmv_csr_team: kernel TeamPolicy modul ini (juga diukur oleh 15_perf_regression)
 
 // MODUL 6: GPU-READY SPMV (HIERARCHICAL PARALLELISM)
 // Tujuan: Menggunakan TeamPolicy untuk memanfaatkan struktur Grid/Block/Thread GPU.
@@ -52,38 +53,11 @@ int main(int argc, char* argv[]) {
     // - TeamSize: Jumlah Thread per Tim (mirip CUDA Block Size / Threads per Block). 
     //             Kokkos bisa pilih otomatis dengan Kokkos::AUTO.
     
-    typedef Kokkos::TeamPolicy<> policy_t;
-    typedef policy_t::member_type member_t; // Member adalah satu thread dalam tim
-
-    Kokkos::parallel_for("SpMV_Team", policy_t(num_rows, Kokkos::AUTO), KOKKOS_LAMBDA(const member_t& team_member) {
-        
-        // 1. Dapatkan Baris yang dikerjakan oleh Tim ini
-        // team_member.league_rank() = Block ID (0..num_rows-1)
-        int row = team_member.league_rank(); 
-
-        double row_sum = 0.0;
-        int row_start = row_map(row);
-        int row_end   = row_map(row+1);
-        int row_len   = row_end - row_start;
-
-        // 2. Parallel Reduce DALAM TIM (Intra-Team)
-        // Semua thread dalam satu tim bekerja sama menghitung satu baris.
-        // Ini disebut "Thread-Level Parallelism" untuk menangani baris yang sangat panjang (mencegah load imbalance).
-        // Kokkos::TeamThreadRange(team_member, count) -> Loop paralel selebar tim.
-        
-        Kokkos::parallel_reduce(Kokkos::TeamThreadRange(team_member, row_len), [=](const int& k_offset, double& lsum) {
-            // k_offset adalah 0, 1, 2... relatif terhadap awal loop
-            int k = row_start + k_offset; 
-            lsum += values(k) * x(col_idx(k));
-        }, row_sum);
-
-        // 3. Single Thread Write
-        // Hanya satu threads yg menulis hasil akhir ke memori global
-        team_member.team_barrier(); // Tunggu semua hitung selesai (barrier)
-        if (team_member.team_rank() == 0) { // Thread 0 saja yang tulis
-            y(row) = row_sum;
-        }
-    });
+    // Kernel lengkap dengan penjelasan langkah 1-3 ada di spmv_team.hpp (folder ini):
+    //   1. league_rank() -> baris milik tim
+    //   2. parallel_reduce(TeamThreadRange) -> thread dalam tim membagi nnz baris
+    //   3. team_barrier + team_rank() == 0 -> satu thread menulis y(row)
+    spmv_csr_team(row_map, col_idx, values, x, y);
     
     Kokkos::fence();
 
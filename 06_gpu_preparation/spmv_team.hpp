@@ -0,0 +1,44 @@
+#pragma once
+#include <Kokkos_Core.hpp>
+
+// MODUL 6: KERNEL SPMV TEAMPOLICY (HIERARCHICAL PARALLELISM)
+// Kernel pelajaran Modul 6, dipanggil oleh spmv_gpu.cpp. Berada di header agar 15_perf_regression
+// (lewat common/kernels.hpp) mengukur kode yang SAMA persis dengan yang diajarkan di sini.
+// Lihat "GPU NOTE 2" di spmv_gpu.cpp untuk arti LeagueSize / TeamSize.
+inline void spmv_csr_team(Kokkos::View<int*> row_map, Kokkos::View<int*> col_idx, Kokkos::View<double*> values,
+                          Kokkos::View<double*> x, Kokkos::View<double*> y) {
+    const int num_rows = (int)y.extent(0);
+
+    typedef Kokkos::TeamPolicy<> policy_t;
+    typedef policy_t::member_type member_t; // Member adalah satu thread dalam tim
+
+    Kokkos::parallel_for("SpMV_Team", policy_t(num_rows, Kokkos::AUTO), KOKKOS_LAMBDA(const member_t& team_member) {
+        
+        // 1. Dapatkan Baris yang dikerjakan oleh Tim ini
+        // team_member.league_rank() = Block ID (0..num_rows-1)
+        int row = team_member.league_rank(); 
+
+        double row_sum = 0.0;
+        int row_start = row_map(row);
+        int row_end   = row_map(row+1);
+        int row_len   = row_end - row_start;
+
+        // 2. Parallel Reduce DALAM TIM (Intra-Team)
+        // Semua thread dalam satu tim bekerja sama menghitung satu baris.
+        // Ini disebut "Thread-Level Parallelism" untuk menangani baris yang sangat panjang (mencegah load imbalance).
+        // Kokkos::TeamThreadRange(team_member, count) -> Loop paralel selebar tim.
+        
+        Kokkos::parallel_reduce(Kokkos::TeamThreadRange(team_member, row_len), [=](const int& k_offset, double& lsum) {
+            // k_offset adalah 0, 1, 2... relatif terhadap awal loop
+            int k = row_start + k_offset; 
+            lsum += values(k) * x(col_idx(k));
+        }, row_sum);
+
+        // 3. Single Thread Write
+        // Hanya satu threads yg menulis hasil akhir ke memori global
+        team_member.team_barrier(); // Tunggu semua hitung selesai (barrier)
+        if (team_member.team_rank() == 0) { // Thread 0 saja yang tulis
+            y(row) = row_sum;
+        }
+    });
+}
@@ -0,0 +1,344 @@
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Timer.hpp>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+// MODUL 8: BATCHED SPMV (BANYAK SISTEM KECIL, SATU LAUNCH)
+// Masalah: Workload ensemble punya ribuan matriks kecil (1k-50k baris) per step.
+// Kalau tiap matriks di-launch sendiri (seperti benchmark_spmv), waktu habis untuk
+// overhead dispatch kernel + fence, bukan untuk hitungan.
+// Solusi: Satu TeamPolicy launch untuk seluruh batch, 1 Tim = 1 Sistem.
+//
+// Dua format batch:
+//   A. Concatenated CSR : semua sistem disambung, batch_offset(s) = baris pertama sistem s.
+//                         Ukuran tiap sistem boleh berbeda.
+//   B. Shared Pattern   : satu row_map/col_idx untuk semua sistem, values per sistem (2D View).
+
+// --- 1. DATA STRUCTURES (HOST SIDE) ---
+struct HostCSR {
+    int num_rows;
+    int num_nnz;
+    std::vector<int> row_map;
+    std::vector<int> col_idx;
+    std::vector<double> values;
+};
+
+// Concatenated CSR: row_map global (offset nnz), col_idx LOKAL per sistem
+// (kolom 0..n_s-1), sehingga x(batch_offset(s) + col) adalah entri x milik sistem s.
+struct BatchedCSR {
+    Kokkos::View<int*>    batch_offset; // Size = num_systems + 1 (offset baris)
+    Kokkos::View<int*>    row_map;      // Size = total_rows + 1
+    Kokkos::View<int*>    col_idx;      // Size = total_nnz
+    Kokkos::View<double*> values;       // Size = total_nnz
+    int num_systems;
+    int total_rows;
+    int total_nnz;
+};
+
+// Shared Pattern: pola sama, nilai beda. values(s, k) contiguous per sistem.
+struct SharedPatternBatch {
+    Kokkos::View<int*>     row_map; // Size = num_rows + 1
+    Kokkos::View<int*>     col_idx; // Size = num_nnz
+    Kokkos::View<double**> values;  // (num_systems, num_nnz)
+    int num_systems;
+    int num_rows;
+    int num_nnz;
+};
+
+// --- 2. GENERATOR STENCIL 3D KECIL (NATURAL ORDER) ---
+// Diagonal = 6, tetangga = -1 (Laplacian), di-scale per sistem supaya hasil tiap sistem beda.
+HostCSR generate_3d_stencil(int nx, int ny, int nz, double scale) {
+    HostCSR mat;
+    mat.num_rows = nx * ny * nz;
+    mat.row_map.push_back(0);
+
+    auto get_idx = [&](int x, int y, int z) { return x + y*nx + z*nx*ny; };
+
+    // Urutan push sudah menghasilkan kolom terurut (z-1, y-1, x-1, self, x+1, y+1, z+1)
+    for(int z=0; z<nz; z++) {
+        for(int y=0; y<ny; y++) {
+            for(int x=0; x<nx; x++) {
+                int u = get_idx(x,y,z);
+                auto push = [&](int col, double val) {
+                    mat.col_idx.push_back(col);
+                    mat.values.push_back(scale * val);
+                };
+                if(z>0)    push(get_idx(x, y, z-1), -1.0);
+                if(y>0)    push(get_idx(x, y-1, z), -1.0);
+                if(x>0)    push(get_idx(x-1, y, z), -1.0);
+                push(u, 6.0);
+                if(x<nx-1) push(get_idx(x+1, y, z), -1.0);
+                if(y<ny-1) push(get_idx(x, y+1, z), -1.0);
+                if(z<nz-1) push(get_idx(x, y, z+1), -1.0);
+                mat.row_map.push_back((int)mat.col_idx.size());
+            }
+        }
+    }
+    mat.num_nnz = (int)mat.col_idx.size();
+    return mat;
+}
+
+// Sistem ke-s: grid (nx + s%3) x ny x nz -> ukuran sistem bervariasi sedikit
+// agar format concatenated benar-benar diuji dengan ukuran tidak seragam.
+BatchedCSR build_concatenated_batch(int num_systems, int nx, int ny, int nz) {
+    std::vector<HostCSR> systems;
+    systems.reserve(num_systems);
+    int total_rows = 0;
+    int total_nnz = 0;
+    for(int s=0; s<num_systems; s++) {
+        systems.push_back(generate_3d_stencil(nx + s%3, ny, nz, 1.0 + 0.001*s));
+        total_rows += systems.back().num_rows;
+        total_nnz  += systems.back().num_nnz;
+    }
+
+    BatchedCSR b;
+    b.num_systems  = num_systems;
+    b.total_rows   = total_rows;
+    b.total_nnz    = total_nnz;
+    b.batch_offset = Kokkos::View<int*>("batch_offset", num_systems + 1);
+    b.row_map      = Kokkos::View<int*>("row_map", total_rows + 1);
+    b.col_idx      = Kokkos::View<int*>("col_idx", total_nnz);
+    b.values       = Kokkos::View<double*>("values", total_nnz);
+
+    auto h_off = Kokkos::create_mirror_view(b.batch_offset);
+    auto h_row = Kokkos::create_mirror_view(b.row_map);
+    auto h_col = Kokkos::create_mirror_view(b.col_idx);
+    auto h_val = Kokkos::create_mirror_view(b.values);
+
+    int row_base = 0;
+    int nnz_base = 0;
+    h_off(0) = 0;
+    h_row(0) = 0;
+    for(int s=0; s<num_systems; s++) {
+        const HostCSR& m = systems[s];
+        for(int i=0; i<m.num_rows; i++) h_row(row_base + i + 1) = nnz_base + m.row_map[i+1];
+        for(int k=0; k<m.num_nnz; k++) {
+            h_col(nnz_base + k) = m.col_idx[k]; // Tetap lokal
+            h_val(nnz_base + k) = m.values[k];
+        }
+        row_base += m.num_rows;
+        nnz_base += m.num_nnz;
+        h_off(s+1) = row_base;
+    }
+
+    Kokkos::deep_copy(b.batch_offset, h_off);
+    Kokkos::deep_copy(b.row_map, h_row);
+    Kokkos::deep_copy(b.col_idx, h_col);
+    Kokkos::deep_copy(b.values, h_val);
+    return b;
+}
+
+SharedPatternBatch build_shared_pattern_batch(int num_systems, int nx, int ny, int nz) {
+    HostCSR pattern = generate_3d_stencil(nx, ny, nz, 1.0);
+
+    SharedPatternBatch b;
+    b.num_systems = num_systems;
+    b.num_rows    = pattern.num_rows;
+    b.num_nnz     = pattern.num_nnz;
+    b.row_map     = Kokkos::View<int*>("row_map", b.num_rows + 1);
+    b.col_idx     = Kokkos::View<int*>("col_idx", b.num_nnz);
+    b.values      = Kokkos::View<double**>("values", num_systems, b.num_nnz);
+
+    auto h_row = Kokkos::create_mirror_view(b.row_map);
+    auto h_col = Kokkos::create_mirror_view(b.col_idx);
+    auto h_val = Kokkos::create_mirror_view(b.values);
+
+    for(int i=0; i<=b.num_rows; i++) h_row(i) = pattern.row_map[i];
+    for(int k=0; k<b.num_nnz; k++)   h_col(k) = pattern.col_idx[k];
+    for(int s=0; s<num_systems; s++) {
+        for(int k=0; k<b.num_nnz; k++) h_val(s, k) = (1.0 + 0.001*s) * pattern.values[k];
+    }
+
+    Kokkos::deep_copy(b.row_map, h_row);
+    Kokkos::deep_copy(b.col_idx, h_col);
+    Kokkos::deep_copy(b.values, h_val);
+    return b;
+}
+
+// --- 3. KERNELS ---
+typedef Kokkos::TeamPolicy<> policy_t;
+typedef policy_t::member_type member_t;
+
+// Batched (Concatenated): 1 launch, 1 Tim = 1 Sistem.
+// TeamThreadRange -> baris sistem, ThreadVectorRange -> nnz dalam baris.
+void batched_spmv(const BatchedCSR& A, Kokkos::View<double*> x, Kokkos::View<double*> y) {
+    auto batch_offset = A.batch_offset;
+    auto row_map = A.row_map;
+    auto col_idx = A.col_idx;
+    auto values  = A.values;
+
+    Kokkos::parallel_for("BatchedSpMV_Concat", policy_t(A.num_systems, Kokkos::AUTO), KOKKOS_LAMBDA(const member_t& team) {
+        const int s = team.league_rank();
+        const int row_begin = batch_offset(s);
+        const int row_end   = batch_offset(s+1);
+
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(team, row_begin, row_end), [&](const int i) {
+            double sum = 0.0;
+            Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(team, row_map(i), row_map(i+1)),
+                [&](const int k, double& lsum) {
+                    lsum += values(k) * x(row_begin + col_idx(k));
+                }, sum);
+            Kokkos::single(Kokkos::PerThread(team), [&]() { y(i) = sum; });
+        });
+    });
+}
+
+// Batched (Shared Pattern): row_map/col_idx dibaca ulang oleh semua tim -> tinggal di cache.
+void batched_spmv(const SharedPatternBatch& A, Kokkos::View<double**> x, Kokkos::View<double**> y) {
+    auto row_map = A.row_map;
+    auto col_idx = A.col_idx;
+    auto values  = A.values;
+    const int num_rows = A.num_rows;
+
+    Kokkos::parallel_for("BatchedSpMV_Shared", policy_t(A.num_systems, Kokkos::AUTO), KOKKOS_LAMBDA(const member_t& team) {
+        const int s = team.league_rank();
+
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(team, num_rows), [&](const int i) {
+            double sum = 0.0;
+            Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(team, row_map(i), row_map(i+1)),
+                [&](const int k, double& lsum) {
+                    lsum += values(s, k) * x(s, col_idx(k));
+                }, sum);
+            Kokkos::single(Kokkos::PerThread(team), [&]() { y(s, i) = sum; });
+        });
+    });
+}
+
+// Baseline: loop SpMV per sistem (1 parallel_for + fence per sistem),
+// persis pola benchmark_spmv kalau dipanggil berulang-ulang.
+// h_off = mirror host dari batch_offset, disalin SEKALI oleh pemanggil (di luar timer):
+// di backend device, deep_copy tiap panggilan akan ikut terukur sebagai transfer D->H.
+void loop_spmv(const BatchedCSR& A, Kokkos::View<int*>::HostMirror h_off,
+               Kokkos::View<double*> x, Kokkos::View<double*> y) {
+    auto row_map = A.row_map;
+    auto col_idx = A.col_idx;
+    auto values  = A.values;
+
+    for(int s=0; s<A.num_systems; s++) {
+        const int row_begin = h_off(s);
+        const int row_end   = h_off(s+1);
+        Kokkos::parallel_for("SpMV_Loop", Kokkos::RangePolicy<>(row_begin, row_end), KOKKOS_LAMBDA(const int i) {
+            double sum = 0.0;
+            for (int k = row_map(i); k < row_map(i+1); k++) {
+                sum += values(k) * x(row_begin + col_idx(k));
+            }
+            y(i) = sum;
+        });
+        Kokkos::fence();
+    }
+}
+
+void loop_spmv(const SharedPatternBatch& A, Kokkos::View<double**> x, Kokkos::View<double**> y) {
+    auto row_map = A.row_map;
+    auto col_idx = A.col_idx;
+    auto values  = A.values;
+
+    for(int s=0; s<A.num_systems; s++) {
+        Kokkos::parallel_for("SpMV_Loop_Shared", A.num_rows, KOKKOS_LAMBDA(const int i) {
+            double sum = 0.0;
+            for (int k = row_map(i); k < row_map(i+1); k++) {
+                sum += values(s, k) * x(s, col_idx(k));
+            }
+            y(s, i) = sum;
+        });
+        Kokkos::fence();
+    }
+}
+
+// --- 4. HELPERS ---
+template <class ViewType>
+double max_abs_diff(ViewType a, ViewType b) {
+    auto h_a = Kokkos::create_mirror_view(a);
+    auto h_b = Kokkos::create_mirror_view(b);
+    Kokkos::deep_copy(h_a, a);
+    Kokkos::deep_copy(h_b, b);
+    double diff = 0.0;
+    const double* pa = h_a.data();
+    const double* pb = h_b.data();
+    for(size_t i=0; i<h_a.size(); i++) {
+        double d = pa[i] - pb[i];
+        if(d < 0) d = -d;
+        if(d > diff) diff = d;
+    }
+    return diff;
+}
+
+template <class Func>
+double time_kernel(Func f, int repeat) {
+    f(); // Warmup
+    Kokkos::fence();
+    Kokkos::Timer timer;
+    for(int iter=0; iter<repeat; iter++) f();
+    Kokkos::fence();
+    return timer.seconds() / repeat;
+}
+
+// --- 5. BENCHMARK ---
+void run_batch(int num_systems, int grid_dim) {
+    // Batch besar = kerja per launch besar -> repeat lebih sedikit sudah stabil
+    const int repeat = num_systems >= 1000 ? 5 : 20;
+
+    // A. Concatenated CSR
+    {
+        BatchedCSR A = build_concatenated_batch(num_systems, grid_dim, grid_dim, grid_dim);
+        Kokkos::View<double*> x("x", A.total_rows);
+        Kokkos::View<double*> y_loop("y_loop", A.total_rows);
+        Kokkos::View<double*> y_batch("y_batch", A.total_rows);
+        Kokkos::deep_copy(x, 1.0);
+        auto h_off = Kokkos::create_mirror_view(A.batch_offset);
+        Kokkos::deep_copy(h_off, A.batch_offset);
+
+        double t_loop  = time_kernel([&]() { loop_spmv(A, h_off, x, y_loop); }, repeat);
+        double t_batch = time_kernel([&]() { batched_spmv(A, x, y_batch); }, repeat);
+        double err = max_abs_diff(y_loop, y_batch);
+
+        printf("%8d | Concat | %9d | %10d | %10.6f | %6.2f | %10.6f | %6.2f | %6.2fx | %.1e\n",
+               num_systems, A.total_rows, A.total_nnz,
+               t_loop,  (2.0*A.total_nnz*1e-9)/t_loop,
+               t_batch, (2.0*A.total_nnz*1e-9)/t_batch,
+               t_loop / t_batch, err);
+    }
+
+    // B. Shared Pattern
+    {
+        SharedPatternBatch A = build_shared_pattern_batch(num_systems, grid_dim, grid_dim, grid_dim);
+        Kokkos::View<double**> x("x", num_systems, A.num_rows);
+        Kokkos::View<double**> y_loop("y_loop", num_systems, A.num_rows);
+        Kokkos::View<double**> y_batch("y_batch", num_systems, A.num_rows);
+        Kokkos::deep_copy(x, 1.0);
+
+        double total_nnz = (double)A.num_nnz * num_systems;
+        double t_loop  = time_kernel([&]() { loop_spmv(A, x, y_loop); }, repeat);
+        double t_batch = time_kernel([&]() { batched_spmv(A, x, y_batch); }, repeat);
+        double err = max_abs_diff(y_loop, y_batch);
+
+        printf("%8d | Shared | %9lld | %10.0f | %10.6f | %6.2f | %10.6f | %6.2f | %6.2fx | %.1e\n",
+               num_systems, (long long)A.num_rows * num_systems, total_nnz,
+               t_loop,  (2.0*total_nnz*1e-9)/t_loop,
+               t_batch, (2.0*total_nnz*1e-9)/t_batch,
+               t_loop / t_batch, err);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Kokkos::initialize(argc, argv);
+    {
+        // Usage: ./08_batched_spmv [grid_dim] [max_batch]
+        // grid_dim 10 -> 1000 baris per sistem (batas bawah workload ensemble).
+        // Hati-hati memori: 10.000 sistem x 1000 baris ~ 64M NNZ (~1 GB untuk format Concat).
+        int grid_dim  = argc > 1 ? std::atoi(argv[1]) : 10;
+        int max_batch = argc > 2 ? std::atoi(argv[2]) : 10000;
+
+        printf("=== KOKKOS BATCHED SPMV (1 TEAM = 1 SYSTEM) ===\n");
+        printf("System: %d^3 Stencil (~%d rows each)\n\n", grid_dim, grid_dim*grid_dim*grid_dim);
+        printf("%8s | %6s | %9s | %10s | %10s | %6s | %10s | %6s | %7s | %s\n",
+               "Batch", "Format", "Rows", "NNZ", "Loop (s)", "GFLOPs", "Batch (s)", "GFLOPs", "Speedup", "MaxErr");
+
+        for(int num_systems = 10; num_systems <= max_batch; num_systems *= 10) {
+            run_batch(num_systems, grid_dim);
+        }
+    }
+    Kokkos::finalize();
+    return 0;
+}
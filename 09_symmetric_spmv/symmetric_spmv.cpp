@@ -0,0 +1,420 @@
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Timer.hpp>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
+#include "host_csr.hpp" // HostCSR, generate_3d_stencil, permute_matrix (perm[old] = new), metis_nodend
+
+// MODUL 9: SYMMETRIC-STORAGE SPMV (UPPER TRIANGLE + DIAGONAL)
+// Matriks stencil 3D (05_reordering, 07_gpu_benchmark) simetris secara struktur DAN nilai.
+// Full CSR menyimpan & membaca kedua segitiga -> trafik col_idx/values 2x lipat untuk kernel
+// yang bandwidth-bound. Di sini kita simpan hanya segitiga atas (j >= i), lalu:
+//   y(i) += a_ij * x(j)   (gather, aman: baris i milik satu thread)
+//   y(j) += a_ij * x(i)   (scatter/mirror, RACE jika paralel naif!)
+// Dua strategi tanpa atomic untuk bagian scatter:
+//   A. Private  : tiap thread punya buffer y sendiri, sebatas window kolom yang bisa ia tulis,
+//                 lalu dijumlah. (CPU)
+//   B. Coloured : baris dibagi blok, blok yang write-set-nya bentrok diberi warna beda.
+//                 Satu warna = satu parallel_for, tidak ada dua blok yang menulis y yang sama.
+
+// --- 1. SYMMETRIC CSR (DEVICE) ---
+struct SymCSR {
+    Kokkos::View<int*>    row_map;
+    Kokkos::View<int*>    col_idx; // Hanya j >= i, diagonal di posisi pertama tiap baris
+    Kokkos::View<double*> values;
+    int num_rows;
+    int num_nnz;
+    // Jadwal pewarnaan blok (dibangun sekali, dipakai ulang)
+    int block_size;
+    Kokkos::View<int*> color_blocks;     // Blok diurutkan per warna
+    std::vector<int>   h_color_ptr;      // Offset warna ke color_blocks (host, untuk loop launch)
+};
+
+struct FullCSR {
+    Kokkos::View<int*>    row_map;
+    Kokkos::View<int*>    col_idx;
+    Kokkos::View<double*> values;
+    int num_rows;
+    int num_nnz;
+};
+
+FullCSR upload_full(const HostCSR& h) {
+    FullCSR A;
+    A.num_rows = h.num_rows;
+    A.num_nnz  = h.num_nnz;
+    A.row_map  = Kokkos::View<int*>("row_map", h.num_rows + 1);
+    A.col_idx  = Kokkos::View<int*>("col_idx", h.num_nnz);
+    A.values   = Kokkos::View<double*>("values", h.num_nnz);
+
+    auto h_row = Kokkos::create_mirror_view(A.row_map);
+    auto h_col = Kokkos::create_mirror_view(A.col_idx);
+    auto h_val = Kokkos::create_mirror_view(A.values);
+    for(int i=0; i<=h.num_rows; i++) h_row(i) = h.row_map[i];
+    for(int k=0; k<h.num_nnz; k++) {
+        h_col(k) = h.col_idx[k];
+        h_val(k) = h.values[k];
+    }
+    Kokkos::deep_copy(A.row_map, h_row);
+    Kokkos::deep_copy(A.col_idx, h_col);
+    Kokkos::deep_copy(A.values, h_val);
+    return A;
+}
+
+// Ambil segitiga atas (CSR terurut -> entri j >= i sudah berurutan, diagonal duluan).
+// Sekaligus bangun jadwal warna blok: write-set blok B = {i in B} U {j : a_ij, i in B}.
+SymCSR build_symmetric(const HostCSR& h, int block_size) {
+    int N = h.num_rows;
+    std::vector<int> row_map(1, 0), col_idx;
+    std::vector<double> values;
+    for(int i=0; i<N; i++) {
+        for(int k=h.row_map[i]; k<h.row_map[i+1]; k++) {
+            if(h.col_idx[k] >= i) {
+                col_idx.push_back(h.col_idx[k]);
+                values.push_back(h.values[k]);
+            }
+        }
+        row_map.push_back((int)col_idx.size());
+    }
+
+    SymCSR A;
+    A.num_rows   = N;
+    A.num_nnz    = (int)col_idx.size();
+    A.block_size = block_size;
+    A.row_map    = Kokkos::View<int*>("sym_row_map", N + 1);
+    A.col_idx    = Kokkos::View<int*>("sym_col_idx", A.num_nnz);
+    A.values     = Kokkos::View<double*>("sym_values", A.num_nnz);
+
+    auto h_row = Kokkos::create_mirror_view(A.row_map);
+    auto h_col = Kokkos::create_mirror_view(A.col_idx);
+    auto h_val = Kokkos::create_mirror_view(A.values);
+    for(int i=0; i<=N; i++) h_row(i) = row_map[i];
+    for(int k=0; k<A.num_nnz; k++) {
+        h_col(k) = col_idx[k];
+        h_val(k) = values[k];
+    }
+    Kokkos::deep_copy(A.row_map, h_row);
+    Kokkos::deep_copy(A.col_idx, h_col);
+    Kokkos::deep_copy(A.values, h_val);
+
+    // --- Greedy block colouring ---
+    int num_blocks = (N + block_size - 1) / block_size;
+    // writers[r] = daftar blok yang menulis y(r) (format CSR: writer_ptr/writer_blk)
+    std::vector<int> writer_cnt(N + 1, 0);
+    for(int i=0; i<N; i++) {
+        for(int k=row_map[i]; k<row_map[i+1]; k++) writer_cnt[col_idx[k] + 1]++; // Termasuk diagonal -> y(i)
+    }
+    for(int r=0; r<N; r++) writer_cnt[r+1] += writer_cnt[r];
+    std::vector<int> writer_blk(writer_cnt[N]);
+    std::vector<int> fill(writer_cnt.begin(), writer_cnt.end() - 1);
+    for(int i=0; i<N; i++) {
+        for(int k=row_map[i]; k<row_map[i+1]; k++) writer_blk[fill[col_idx[k]]++] = i / block_size;
+    }
+
+    std::vector<int> color(num_blocks, -1);
+    std::vector<int> forbidden; // forbidden[c] == b -> warna c terlarang untuk blok b
+    int num_colors = 0;
+    for(int b=0; b<num_blocks; b++) {
+        int row_begin = b * block_size;
+        int row_end   = std::min(N, row_begin + block_size);
+        for(int i=row_begin; i<row_end; i++) {
+            for(int k=row_map[i]; k<row_map[i+1]; k++) {
+                int r = col_idx[k];
+                for(int w=writer_cnt[r]; w<writer_cnt[r+1]; w++) {
+                    int c = color[writer_blk[w]];
+                    if(c >= 0) forbidden[c] = b;
+                }
+            }
+        }
+        int c = 0;
+        while(c < num_colors && forbidden[c] == b) c++;
+        if(c == num_colors) {
+            num_colors++;
+            forbidden.push_back(-1);
+        }
+        color[b] = c;
+    }
+
+    A.h_color_ptr.assign(num_colors + 1, 0);
+    for(int b=0; b<num_blocks; b++) A.h_color_ptr[color[b] + 1]++;
+    for(int c=0; c<num_colors; c++) A.h_color_ptr[c+1] += A.h_color_ptr[c];
+    A.color_blocks = Kokkos::View<int*>("color_blocks", num_blocks);
+    auto h_blocks = Kokkos::create_mirror_view(A.color_blocks);
+    std::vector<int> pos(A.h_color_ptr.begin(), A.h_color_ptr.end() - 1);
+    for(int b=0; b<num_blocks; b++) h_blocks(pos[color[b]]++) = b;
+    Kokkos::deep_copy(A.color_blocks, h_blocks);
+    return A;
+}
+
+// --- 2. KERNELS ---
+void spmv_full(const FullCSR& A, Kokkos::View<double*> x, Kokkos::View<double*> y) {
+    auto row_map = A.row_map;
+    auto col_idx = A.col_idx;
+    auto values  = A.values;
+    Kokkos::parallel_for("SpMV_Full", A.num_rows, KOKKOS_LAMBDA(const int i) {
+        double sum = 0.0;
+        for (int k = row_map(i); k < row_map(i+1); k++) {
+            sum += values(k) * x(col_idx(k));
+        }
+        y(i) = sum;
+    });
+}
+
+// A. Thread-private accumulation.
+// Baris dibagi menjadi P chunk statis (P = concurrency), chunk c selalu dikerjakan thread yang sama
+// (Schedule<Static>, satu iterasi per thread) -> tidak perlu UniqueToken.
+// Segitiga atas: baris i hanya menulis y(j) dengan j >= i, jadi chunk [row_begin, row_end) hanya
+// bisa menyentuh y pada [row_begin, max col_idx chunk]:
+//   - bagian [row_begin, row_end) milik chunk sendiri -> langsung ke y
+//   - bagian [row_end, win_end)  -> buffer private chunk (window), dijumlah di kernel kedua
+// Buffer tidak lagi (P x N): untuk stencil natural window = satu "lapisan" grid (nx*ny),
+// hanya ordering acak (Shuffled) yang window-nya mendekati N. Hanya window yang di-nol-kan & dibaca.
+// Reduksi per chunk penerima, hanya atas window yang overlap dengan barisnya (daftar dibangun sekali):
+// kerja reduksi = ukuran window, bukan O(N * P).
+// HANYA backend host: satu chunk per thread + buffer per chunk tidak skala ke ribuan thread GPU.
+const bool PRIVATE_ON_HOST = std::is_same<Kokkos::DefaultExecutionSpace, Kokkos::DefaultHostExecutionSpace>::value;
+
+struct PrivateWorkspace {
+    int num_chunks;
+    Kokkos::View<int*>    chunk_ptr;     // Batas baris chunk (num_chunks + 1)
+    Kokkos::View<int*>    win_end;       // Akhir window chunk = max col_idx + 1 (>= row_end)
+    Kokkos::View<int*>    buf_ptr;       // Offset window chunk di ybuf (num_chunks + 1)
+    Kokkos::View<int*>    overlap_ptr;   // Chunk c menerima dari overlap_chunk[overlap_ptr(c) .. overlap_ptr(c+1))
+    Kokkos::View<int*>    overlap_chunk;
+    Kokkos::View<double*> ybuf;
+};
+
+PrivateWorkspace make_private_workspace(const SymCSR& A) {
+    const int N = A.num_rows;
+    PrivateWorkspace ws;
+    ws.num_chunks = Kokkos::DefaultExecutionSpace().concurrency();
+    ws.chunk_ptr  = Kokkos::View<int*>("chunk_ptr", ws.num_chunks + 1);
+    ws.win_end    = Kokkos::View<int*>("win_end", ws.num_chunks);
+    ws.buf_ptr    = Kokkos::View<int*>("buf_ptr", ws.num_chunks + 1);
+
+    auto h_row = Kokkos::create_mirror_view(A.row_map);
+    auto h_col = Kokkos::create_mirror_view(A.col_idx);
+    Kokkos::deep_copy(h_row, A.row_map);
+    Kokkos::deep_copy(h_col, A.col_idx);
+
+    auto h_chunk = Kokkos::create_mirror_view(ws.chunk_ptr);
+    auto h_win   = Kokkos::create_mirror_view(ws.win_end);
+    auto h_buf   = Kokkos::create_mirror_view(ws.buf_ptr);
+    const int chunk = (N + ws.num_chunks - 1) / ws.num_chunks;
+    h_buf(0) = 0;
+    for(int c=0; c<ws.num_chunks; c++) {
+        int row_begin = std::min(N, c * chunk);
+        int row_end   = std::min(N, row_begin + chunk);
+        int max_col   = row_end - 1;
+        for(int k=h_row(row_begin); k<h_row(row_end); k++) max_col = std::max(max_col, h_col(k));
+        h_chunk(c)  = row_begin;
+        h_win(c)    = std::max(row_end, max_col + 1);
+        h_buf(c+1)  = h_buf(c) + (h_win(c) - row_end);
+    }
+    h_chunk(ws.num_chunks) = N;
+    // Window chunk t = [row_end_t, win_end_t) hanya bisa overlap chunk setelahnya (t < c)
+    std::vector<int> overlap_ptr(1, 0), overlap_chunk;
+    for(int c=0; c<ws.num_chunks; c++) {
+        for(int t=0; t<c; t++) {
+            if(h_win(t) > h_chunk(c) && h_chunk(t+1) < h_chunk(c+1)) overlap_chunk.push_back(t);
+        }
+        overlap_ptr.push_back((int)overlap_chunk.size());
+    }
+    ws.overlap_ptr   = Kokkos::View<int*>("overlap_ptr", overlap_ptr.size());
+    ws.overlap_chunk = Kokkos::View<int*>("overlap_chunk", overlap_chunk.size());
+    auto h_optr = Kokkos::create_mirror_view(ws.overlap_ptr);
+    auto h_ochk = Kokkos::create_mirror_view(ws.overlap_chunk);
+    for(size_t k=0; k<overlap_ptr.size(); k++) h_optr(k) = overlap_ptr[k];
+    for(size_t k=0; k<overlap_chunk.size(); k++) h_ochk(k) = overlap_chunk[k];
+
+    Kokkos::deep_copy(ws.chunk_ptr, h_chunk);
+    Kokkos::deep_copy(ws.win_end, h_win);
+    Kokkos::deep_copy(ws.buf_ptr, h_buf);
+    Kokkos::deep_copy(ws.overlap_ptr, h_optr);
+    Kokkos::deep_copy(ws.overlap_chunk, h_ochk);
+    ws.ybuf = Kokkos::View<double*>("ybuf", h_buf(ws.num_chunks));
+    return ws;
+}
+
+void spmv_sym_private(const SymCSR& A, PrivateWorkspace& ws, Kokkos::View<double*> x, Kokkos::View<double*> y) {
+    auto row_map   = A.row_map;
+    auto col_idx   = A.col_idx;
+    auto values    = A.values;
+    auto chunk_ptr = ws.chunk_ptr;
+    auto win_end   = ws.win_end;
+    auto buf_ptr   = ws.buf_ptr;
+    auto overlap_ptr   = ws.overlap_ptr;
+    auto overlap_chunk = ws.overlap_chunk;
+    auto ybuf      = ws.ybuf;
+    const int num_chunks = ws.num_chunks;
+
+    Kokkos::parallel_for("SpMV_Sym_Private", Kokkos::RangePolicy<Kokkos::Schedule<Kokkos::Static>>(0, num_chunks),
+        KOKKOS_LAMBDA(const int c) {
+            const int row_begin = chunk_ptr(c);
+            const int row_end   = chunk_ptr(c+1);
+            const int offset    = buf_ptr(c);
+            // Nol-kan hanya milik sendiri (window + baris chunk) -> first touch oleh thread pemilik
+            for (int p = offset; p < buf_ptr(c+1); p++) ybuf(p) = 0.0;
+            for (int i = row_begin; i < row_end; i++) y(i) = 0.0;
+            for (int i = row_begin; i < row_end; i++) {
+                const double xi = x(i);
+                double sum = 0.0;
+                for (int k = row_map(i); k < row_map(i+1); k++) {
+                    const int j = col_idx(k);
+                    sum += values(k) * x(j);
+                    if (j == i) continue;
+                    if (j < row_end) y(j) += values(k) * xi;                 // Mirror di dalam chunk
+                    else             ybuf(offset + j - row_end) += values(k) * xi; // Mirror ke window
+                }
+                y(i) += sum;
+            }
+        });
+
+    // Chunk c menjumlah window t (urutan t tetap -> deterministik) ke barisnya sendiri
+    Kokkos::parallel_for("SpMV_Sym_Private_Reduce", Kokkos::RangePolicy<Kokkos::Schedule<Kokkos::Static>>(0, num_chunks),
+        KOKKOS_LAMBDA(const int c) {
+            const int row_begin = chunk_ptr(c);
+            const int row_end   = chunk_ptr(c+1);
+            for (int o = overlap_ptr(c); o < overlap_ptr(c+1); o++) {
+                const int t = overlap_chunk(o);
+                const int src_begin = chunk_ptr(t+1); // Window t dimulai di row_end chunk t (<= row_begin)
+                const int hi = win_end(t) < row_end ? win_end(t) : row_end;
+                const int offset = buf_ptr(t) - src_begin;
+                for (int i = row_begin; i < hi; i++) y(i) += ybuf(offset + i);
+            }
+        });
+}
+
+// B. Block colouring: satu launch per warna, tiap blok diproses serial oleh satu thread.
+void spmv_sym_colored(const SymCSR& A, Kokkos::View<double*> x, Kokkos::View<double*> y) {
+    auto row_map = A.row_map;
+    auto col_idx = A.col_idx;
+    auto values  = A.values;
+    auto color_blocks = A.color_blocks;
+    const int N = A.num_rows;
+    const int block_size = A.block_size;
+
+    Kokkos::deep_copy(y, 0.0);
+
+    const int num_colors = (int)A.h_color_ptr.size() - 1;
+    for (int c = 0; c < num_colors; c++) {
+        Kokkos::parallel_for("SpMV_Sym_Colored", Kokkos::RangePolicy<>(A.h_color_ptr[c], A.h_color_ptr[c+1]),
+            KOKKOS_LAMBDA(const int p) {
+                const int b = color_blocks(p);
+                const int row_begin = b * block_size;
+                const int row_end   = row_begin + block_size < N ? row_begin + block_size : N;
+                for (int i = row_begin; i < row_end; i++) {
+                    const double xi = x(i);
+                    double sum = 0.0;
+                    for (int k = row_map(i); k < row_map(i+1); k++) {
+                        const int j = col_idx(k);
+                        sum += values(k) * x(j);
+                        if (j != i) y(j) += values(k) * xi;
+                    }
+                    y(i) += sum;
+                }
+            });
+    }
+}
+
+// --- 3. BENCHMARK ---
+template <class Func>
+double time_kernel(Func f, int repeat) {
+    f(); // Warmup
+    Kokkos::fence();
+    Kokkos::Timer timer;
+    for(int iter=0; iter<repeat; iter++) f();
+    Kokkos::fence();
+    return timer.seconds() / repeat;
+}
+
+double max_abs_diff(Kokkos::View<double*> a, Kokkos::View<double*> b) {
+    auto h_a = Kokkos::create_mirror_view(a);
+    auto h_b = Kokkos::create_mirror_view(b);
+    Kokkos::deep_copy(h_a, a);
+    Kokkos::deep_copy(h_b, b);
+    double diff = 0.0;
+    for(size_t i=0; i<h_a.extent(0); i++) {
+        double d = h_a(i) - h_b(i);
+        if(d < 0) d = -d;
+        if(d > diff) diff = d;
+    }
+    return diff;
+}
+
+void run_case(const char* label, const HostCSR& h_mat, int block_size, int repeat) {
+    int N = h_mat.num_rows;
+    FullCSR full = upload_full(h_mat);
+    SymCSR  sym  = build_symmetric(h_mat, block_size);
+    PrivateWorkspace ws;
+    if(PRIVATE_ON_HOST) ws = make_private_workspace(sym);
+
+    Kokkos::View<double*> x("x", N);
+    Kokkos::View<double*> y_full("y_full", N);
+    Kokkos::View<double*> y_priv("y_priv", N);
+    Kokkos::View<double*> y_col("y_col", N);
+
+    // x tidak konstan agar kesalahan mirror terlihat
+    auto h_x = Kokkos::create_mirror_view(x);
+    for(int i=0; i<N; i++) h_x(i) = 1.0 + (i % 7) * 0.25;
+    Kokkos::deep_copy(x, h_x);
+
+    double t_full = time_kernel([&]() { spmv_full(full, x, y_full); }, repeat);
+    double t_priv = PRIVATE_ON_HOST ? time_kernel([&]() { spmv_sym_private(sym, ws, x, y_priv); }, repeat) : 0.0;
+    double t_col  = time_kernel([&]() { spmv_sym_colored(sym, x, y_col); }, repeat);
+
+    double err = max_abs_diff(y_full, y_col);
+    if(PRIVATE_ON_HOST) err = std::max(err, max_abs_diff(y_full, y_priv));
+
+    // Footprint matriks saja (row_map + col_idx + values); buffer private dilaporkan terpisah
+    double mb_full = ((N + 1) * 4.0 + full.num_nnz * 12.0) / 1e6;
+    double mb_sym  = ((N + 1) * 4.0 + sym.num_nnz * 12.0) / 1e6;
+    // Trafik buffer private per SpMV: nol-kan + baca saat reduksi (window saja)
+    double mb_buf  = PRIVATE_ON_HOST ? 2.0 * ws.ybuf.size() * 8.0 / 1e6 : 0.0;
+    // GFLOPs efektif: selalu dihitung dari NNZ full agar sebanding
+    double flops = 2.0 * full.num_nnz * 1e-9;
+
+    printf("[%s] NNZ full=%d sym=%d | Matrix: %.1f MB -> %.1f MB (%.2fx) | Private buf traffic: %.1f MB/SpMV (sym + buf = %.1f MB) | Colours: %d\n",
+           label, full.num_nnz, sym.num_nnz, mb_full, mb_sym, mb_full / mb_sym, mb_buf, mb_sym + mb_buf,
+           (int)sym.h_color_ptr.size() - 1);
+    printf("    Full CSR      : %f s | %.2f GFLOPs\n", t_full, flops / t_full);
+    if(PRIVATE_ON_HOST) printf("    Sym (Private) : %f s | %.2f GFLOPs | %.2fx\n", t_priv, flops / t_priv, t_full / t_priv);
+    else                printf("    Sym (Private) : dilewati (hanya backend host)\n");
+    printf("    Sym (Coloured): %f s | %.2f GFLOPs | %.2fx\n", t_col, flops / t_col, t_full / t_col);
+    printf("    Max |y_full - y_sym| = %.1e\n\n", err);
+}
+
+int main(int argc, char* argv[]) {
+    Kokkos::initialize(argc, argv);
+    {
+        // Usage: ./09_symmetric_spmv [grid_dim] [block_size]
+        int grid_dim   = argc > 1 ? std::atoi(argv[1]) : 80;
+        int block_size = argc > 2 ? std::atoi(argv[2]) : 256;
+        const int REPEAT = 50;
+
+        printf("=== KOKKOS SYMMETRIC SPMV (UPPER TRIANGLE) ===\n");
+        printf("Grid: %d^3 | Block size (colouring): %d | Threads: %d\n\n",
+               grid_dim, block_size, Kokkos::DefaultExecutionSpace().concurrency());
+
+        HostCSR natural = generate_3d_stencil(grid_dim, grid_dim, grid_dim, false);
+        run_case("Natural ", natural, block_size, REPEAT);
+
+        HostCSR shuffled = generate_3d_stencil(grid_dim, grid_dim, grid_dim, true);
+        run_case("Shuffled", shuffled, block_size, REPEAT);
+
+#ifdef HAVE_METIS
+        std::vector<int> perm;
+        if(metis_nodend(shuffled, perm)) {
+            run_case("METIS   ", permute_matrix(shuffled, perm), block_size, REPEAT);
+        } else {
+            printf("[METIS   ] METIS_NodeND gagal, dilewati.\n");
+        }
+#else
+        printf("[METIS   ] Dilewati: dikompilasi tanpa METIS (install libmetis-dev).\n");
+#endif
+    }
+    Kokkos::finalize();
+    return 0;
+}
@@ -0,0 +1,291 @@
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Timer.hpp>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include "host_csr.hpp" // HostCSR, generate_3d_stencil, permute_matrix (perm[old] = new), rcm_ordering, metis_nodend
+
+// MODUL 10: ANALISIS KUALITAS ORDERING (SEBELUM SPMV DIJALANKAN)
+// spmv_metis.cpp hanya bisa menilai ordering dengan menjalankan benchmark 100 iterasi.
+// Di sini kita hitung metrik struktural secara paralel langsung dari View CSR:
+//   - Bandwidth        : max |i - j|
+//   - Profile          : sum_i (i - min_j), envelope segitiga bawah
+//   - Column distance  : rata-rata |i - j| per NNZ, rata-rata & max span (max_j - min_j) per baris
+//   - Reuse cache-line x : simulasi cache set-associative (LRU) per thread untuk akses x(col_idx(k)),
+//                          dengan pembagian baris statis seperti RangePolicy.
+// Dari miss x kita prediksi byte per SpMV -> ranking Natural vs Shuffled vs RCM vs METIS
+// tanpa loop timing. Timing SpMV opsional hanya untuk validasi prediksi.
+// Layak atau tidak: penghematan per SpMV = (Pred MB input - Pred MB reordered) / bandwidth STREAM,
+// break-even = waktu reorder / penghematan per SpMV (jumlah SpMV sampai reorder "lunas").
+
+// --- 1. DATA STRUCTURES (HOST SIDE) ---
+struct CacheModel {
+    int line_bytes;  // Ukuran cache line (byte)
+    int cache_bytes; // Kapasitas cache per thread (byte), mis. L2 per core
+    int ways;        // Asosiativitas
+};
+
+struct OrderingStats {
+    long long bandwidth;
+    double profile;
+    double mean_col_distance; // Rata-rata |i - j| per NNZ
+    double mean_row_span;     // Rata-rata (max_j - min_j) per baris
+    int max_row_span;
+    double x_hit_rate;        // Fraksi akses x yang hit di cache model
+    double x_bytes_per_nnz;   // Trafik x (miss * line) dibagi NNZ
+    double predicted_mb;      // Prediksi trafik memori total per SpMV
+    double analysis_time;
+};
+
+struct OrderingResult {
+    std::string label;
+    double reorder_time;      // 0 -> ordering input, tidak ada biaya reorder
+    OrderingStats stats;
+};
+
+// --- 2. ANALYZER (PARALLEL, LANGSUNG DARI VIEW CSR) ---
+OrderingStats analyze_ordering(Kokkos::View<int*> row_map, Kokkos::View<int*> col_idx,
+                               const CacheModel& cache, int num_chunks) {
+    OrderingStats s;
+    const int N = (int)row_map.extent(0) - 1;
+    const int NNZ = (int)col_idx.extent(0);
+
+    Kokkos::fence();
+    Kokkos::Timer timer;
+
+    long long bandwidth = 0;
+    Kokkos::parallel_reduce("Analyze_Bandwidth", N, KOKKOS_LAMBDA(const int i, long long& lmax) {
+        for (int k = row_map(i); k < row_map(i+1); k++) {
+            long long d = col_idx(k) > i ? col_idx(k) - i : i - col_idx(k);
+            if (d > lmax) lmax = d;
+        }
+    }, Kokkos::Max<long long>(bandwidth));
+
+    double profile = 0.0;
+    Kokkos::parallel_reduce("Analyze_Profile", N, KOKKOS_LAMBDA(const int i, double& lsum) {
+        // Kolom CSR terurut -> col_idx(row_start) adalah kolom minimum
+        if (row_map(i+1) > row_map(i) && col_idx(row_map(i)) < i) lsum += i - col_idx(row_map(i));
+    }, profile);
+
+    double dist_sum = 0.0;
+    Kokkos::parallel_reduce("Analyze_ColDistance", N, KOKKOS_LAMBDA(const int i, double& lsum) {
+        for (int k = row_map(i); k < row_map(i+1); k++) {
+            lsum += col_idx(k) > i ? col_idx(k) - i : i - col_idx(k);
+        }
+    }, dist_sum);
+
+    double span_sum = 0.0;
+    Kokkos::parallel_reduce("Analyze_RowSpan", N, KOKKOS_LAMBDA(const int i, double& lsum) {
+        if (row_map(i+1) > row_map(i)) lsum += col_idx(row_map(i+1) - 1) - col_idx(row_map(i));
+    }, span_sum);
+
+    int max_span = 0;
+    Kokkos::parallel_reduce("Analyze_MaxRowSpan", N, KOKKOS_LAMBDA(const int i, int& lmax) {
+        if (row_map(i+1) > row_map(i)) {
+            int span = col_idx(row_map(i+1) - 1) - col_idx(row_map(i));
+            if (span > lmax) lmax = span;
+        }
+    }, Kokkos::Max<int>(max_span));
+
+    // Simulasi cache x: satu chunk baris kontigu = satu thread (static schedule),
+    // masing-masing dengan cache LRU set-associative privat (tags(chunk, set*ways + w)).
+    const int doubles_per_line = cache.line_bytes / (int)sizeof(double);
+    const int ways = cache.ways;
+    const int num_sets = std::max(1, cache.cache_bytes / (cache.line_bytes * ways));
+    const int chunk = (N + num_chunks - 1) / num_chunks;
+
+    Kokkos::View<int**> tags("cache_tags", num_chunks, num_sets * ways);
+    Kokkos::deep_copy(tags, -1);
+
+    long long misses = 0;
+    Kokkos::parallel_reduce("Analyze_XCache", num_chunks, KOKKOS_LAMBDA(const int c, long long& lmiss) {
+        const int row_begin = c * chunk;
+        const int row_end   = row_begin + chunk < N ? row_begin + chunk : N;
+        for (int i = row_begin; i < row_end; i++) {
+            for (int k = row_map(i); k < row_map(i+1); k++) {
+                const int line = col_idx(k) / doubles_per_line;
+                const int base = (line % num_sets) * ways;
+                int w = 0;
+                while (w < ways && tags(c, base + w) != line) w++;
+                if (w == ways) {
+                    lmiss++;
+                    w = ways - 1; // Evict LRU (posisi terakhir)
+                }
+                // Geser ke depan: posisi 0 = most recently used
+                for (int m = w; m > 0; m--) tags(c, base + m) = tags(c, base + m - 1);
+                tags(c, base) = line;
+            }
+        }
+    }, misses);
+
+    Kokkos::fence();
+    s.analysis_time = timer.seconds();
+
+    s.bandwidth         = bandwidth;
+    s.profile           = profile;
+    s.mean_col_distance = dist_sum / NNZ;
+    s.mean_row_span     = span_sum / N;
+    s.max_row_span      = max_span;
+    s.x_hit_rate        = 1.0 - (double)misses / NNZ;
+    s.x_bytes_per_nnz   = (double)misses * cache.line_bytes / NNZ;
+    // row_map + col_idx + values + tulis y + trafik x dari model
+    s.predicted_mb = ((N + 1) * 4.0 + NNZ * 12.0 + N * 8.0 + (double)misses * cache.line_bytes) / 1e6;
+    return s;
+}
+
+// --- 3. SPMV (HANYA UNTUK VALIDASI PREDIKSI) ---
+double benchmark_spmv(Kokkos::View<int*> row_map, Kokkos::View<int*> col_idx, Kokkos::View<double*> values,
+                      int repeat) {
+    const int N = (int)row_map.extent(0) - 1;
+    Kokkos::View<double*> x("x", N);
+    Kokkos::View<double*> y("y", N);
+    Kokkos::deep_copy(x, 1.0);
+
+    Kokkos::fence();
+    Kokkos::Timer timer;
+    for(int iter=0; iter<repeat; iter++) {
+        Kokkos::parallel_for("SpMV_Run", N, KOKKOS_LAMBDA(const int i) {
+            double sum = 0.0;
+            for (int k = row_map(i); k < row_map(i+1); k++) {
+                sum += values(k) * x(col_idx(k));
+            }
+            y(i) = sum;
+        });
+    }
+    Kokkos::fence();
+    return timer.seconds() / repeat;
+}
+
+// STREAM triad (GB/s), diukur sekali: pembagi untuk mengubah Pred MB menjadi detik
+double measure_stream_bandwidth() {
+    const int n = 1 << 23;
+    Kokkos::View<double*> a("a", n);
+    Kokkos::View<double*> b("b", n);
+    Kokkos::View<double*> c("c", n);
+    Kokkos::deep_copy(b, 1.0);
+    Kokkos::deep_copy(c, 2.0);
+    auto triad = [&]() {
+        Kokkos::parallel_for("STREAM_triad", n, KOKKOS_LAMBDA(const int i) {
+            a(i) = b(i) + 3.0 * c(i);
+        });
+    };
+    triad(); // Warmup (first touch)
+    Kokkos::fence();
+    const int repeat = 10;
+    Kokkos::Timer timer;
+    for(int iter=0; iter<repeat; iter++) triad();
+    Kokkos::fence();
+    return 3.0 * n * sizeof(double) * repeat / timer.seconds() / 1e9;
+}
+
+OrderingResult report(const char* label, const HostCSR& h_mat, double reorder_time,
+                      const CacheModel& cache, int num_chunks, bool run_spmv) {
+    Kokkos::View<int*>    row_map("row_map", h_mat.num_rows + 1);
+    Kokkos::View<int*>    col_idx("col_idx", h_mat.num_nnz);
+    Kokkos::View<double*> values("values", h_mat.num_nnz);
+
+    auto h_row = Kokkos::create_mirror_view(row_map);
+    auto h_col = Kokkos::create_mirror_view(col_idx);
+    auto h_val = Kokkos::create_mirror_view(values);
+    for(int i=0; i<=h_mat.num_rows; i++) h_row(i) = h_mat.row_map[i];
+    for(int k=0; k<h_mat.num_nnz; k++) {
+        h_col(k) = h_mat.col_idx[k];
+        h_val(k) = h_mat.values[k];
+    }
+    Kokkos::deep_copy(row_map, h_row);
+    Kokkos::deep_copy(col_idx, h_col);
+    Kokkos::deep_copy(values, h_val);
+
+    OrderingStats s = analyze_ordering(row_map, col_idx, cache, num_chunks);
+
+    printf("%-8s | %8.3f | %8.4f | %9lld | %10.3e | %9.1f | %9.1f | %9d | %6.1f%% | %6.2f | %8.1f",
+           label, reorder_time, s.analysis_time, s.bandwidth, s.profile,
+           s.mean_col_distance, s.mean_row_span, s.max_row_span,
+           100.0 * s.x_hit_rate, s.x_bytes_per_nnz, s.predicted_mb);
+
+    if(run_spmv) {
+        double t = benchmark_spmv(row_map, col_idx, values, 100);
+        printf(" | %f | %6.2f", t, (2.0*h_mat.num_nnz*1e-9)/t);
+    }
+    printf("\n");
+    return {label, reorder_time, s};
+}
+
+// Ranking berdasarkan Pred MB + break-even tiap reordering terhadap ordering input
+void print_ranking(std::vector<OrderingResult> results, const OrderingResult& input, double bandwidth_gbs) {
+    std::sort(results.begin(), results.end(), [](const OrderingResult& a, const OrderingResult& b) {
+        return a.stats.predicted_mb < b.stats.predicted_mb;
+    });
+    printf("\nRanking (Pred MB, bandwidth %.1f GB/s, input = %s):\n", bandwidth_gbs, input.label.c_str());
+    printf("%4s | %-8s | %8s | %13s | %10s | %s\n", "Rank", "Ordering", "Pred MB", "Hemat/SpMV(s)", "Reord(s)", "Break-even (SpMV)");
+    for(size_t r=0; r<results.size(); r++) {
+        const OrderingResult& o = results[r];
+        double saving_s = (input.stats.predicted_mb - o.stats.predicted_mb) * 1e6 / (bandwidth_gbs * 1e9);
+        printf("%4d | %-8s | %8.1f | %13.3e | %10.3f | ", (int)r + 1, o.label.c_str(), o.stats.predicted_mb,
+               saving_s, o.reorder_time);
+        if(o.reorder_time <= 0.0) printf("- (ordering input)\n");
+        else if(saving_s <= 0.0)  printf("tidak pernah (tidak lebih hemat dari input)\n");
+        else                      printf("%.0f\n", o.reorder_time / saving_s);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Kokkos::initialize(argc, argv);
+    {
+        // Usage: ./10_ordering_analysis [grid_dim] [cache_kb] [line_bytes] [run_spmv 0/1] [bandwidth_gbs]
+        // bandwidth_gbs = 0 / tidak diisi -> diukur sekali dengan STREAM triad
+        int grid_dim   = argc > 1 ? std::atoi(argv[1]) : 80;
+        CacheModel cache;
+        cache.cache_bytes = (argc > 2 ? std::atoi(argv[2]) : 1024) * 1024;
+        cache.line_bytes  = argc > 3 ? std::atoi(argv[3]) : 64;
+        cache.ways        = 8;
+        bool run_spmv     = argc > 4 ? std::atoi(argv[4]) != 0 : false;
+        double bandwidth_gbs = argc > 5 ? std::atof(argv[5]) : 0.0;
+        if(bandwidth_gbs <= 0.0) bandwidth_gbs = measure_stream_bandwidth();
+        int num_chunks    = Kokkos::DefaultExecutionSpace().concurrency();
+
+        printf("=== ORDERING QUALITY ANALYZER (3D STENCIL %d^3) ===\n", grid_dim);
+        printf("Cache model: %d KB per thread, %d B lines, %d-way LRU | Chunks (threads): %d\n\n",
+               cache.cache_bytes / 1024, cache.line_bytes, cache.ways, num_chunks);
+        printf("%-8s | %8s | %8s | %9s | %10s | %9s | %9s | %9s | %7s | %6s | %8s%s\n",
+               "Ordering", "Reord(s)", "Anal(s)", "Bandwidth", "Profile", "MeanDist", "MeanSpan", "MaxSpan",
+               "x Hit", "xB/nnz", "Pred MB", run_spmv ? " | SpMV (s) | GFLOPs" : "");
+
+        std::vector<OrderingResult> results;
+        HostCSR natural = generate_3d_stencil(grid_dim, grid_dim, grid_dim, false);
+        results.push_back(report("Natural", natural, 0.0, cache, num_chunks, run_spmv));
+
+        // RCM & METIS dihitung dari Shuffled -> Shuffled adalah input pembanding break-even
+        HostCSR shuffled = generate_3d_stencil(grid_dim, grid_dim, grid_dim, true);
+        OrderingResult input = report("Shuffled", shuffled, 0.0, cache, num_chunks, run_spmv);
+        results.push_back(input);
+
+        // Waktu reorder = hitung permutasi + permute_matrix, dibandingkan langsung dengan SpMV
+        Kokkos::Timer timer;
+        HostCSR rcm = permute_matrix(shuffled, rcm_ordering(shuffled));
+        double t_rcm = timer.seconds();
+        results.push_back(report("RCM", rcm, t_rcm, cache, num_chunks, run_spmv));
+
+#ifdef HAVE_METIS
+        timer.reset();
+        std::vector<int> perm;
+        if(metis_nodend(shuffled, perm)) {
+            HostCSR metis = permute_matrix(shuffled, perm);
+            double t_metis = timer.seconds();
+            results.push_back(report("METIS", metis, t_metis, cache, num_chunks, run_spmv));
+        } else {
+            printf("%-8s | METIS_NodeND gagal, dilewati.\n", "METIS");
+        }
+#else
+        printf("%-8s | Dilewati: dikompilasi tanpa METIS (install libmetis-dev).\n", "METIS");
+#endif
+        print_ranking(results, input, bandwidth_gbs);
+        printf("\nPred MB = row_map + col_idx + values + y + (miss x * line). Lebih kecil = lebih cepat (bandwidth-bound).\n");
+        printf("Break-even = Reord(s) / Hemat/SpMV(s): setelah sekian SpMV, biaya reorder terbayar.\n");
+    }
+    Kokkos::finalize();
+    return 0;
+}
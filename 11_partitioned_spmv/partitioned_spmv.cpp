@@ -0,0 +1,287 @@
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Timer.hpp>
+#ifdef HAVE_METIS
+#include <metis.h>
+#endif
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include "host_csr.hpp" // HostCSR, generate_3d_stencil, permute_matrix (perm[old] = new)
+
+// MODUL 11: GRAPH-PARTITIONED ROW DISTRIBUTION (LOKALITAS ANTAR CORE)
+// Di 05_reordering, METIS_NodeND hanya dipakai untuk urutan global. Pembagian baris ke thread
+// tetap chunk statis RangePolicy -> thread di core berbeda berbagi cache line x di batas chunk.
+// Di sini:
+//   1. Partisi graf menjadi k bagian (k = jumlah thread) dengan METIS_PartGraphKway,
+//      atau fallback in-tree (BFS dari node perifer, dipotong k bagian sama besar).
+//   2. Renumber baris: kontigu per partisi, baris INTERIOR dulu, baris BOUNDARY terakhir.
+//   3. Jalankan SpMV dengan 1 partisi = 1 thread (Schedule<Static>, chunk 1).
+// Scaling 1..semua core: k partisi -> hanya k thread yang bekerja (iterasi statis).
+
+// --- 1. DATA STRUCTURES (HOST SIDE) ---
+// Hasil partisi setelah renumbering: partisi p = baris [part_ptr[p], part_ptr[p+1]),
+// interior = [part_ptr[p], interior_end[p]), boundary = [interior_end[p], part_ptr[p+1]).
+struct RowPartition {
+    std::vector<int> perm; // perm[old] = new
+    std::vector<int> part_ptr;
+    std::vector<int> interior_end;
+    std::vector<int> cut;  // Edge keluar partisi per partisi (= baca x remote)
+};
+
+// --- 2. PARTITIONING ---
+// Fallback in-tree: BFS dari node derajat minimum (pojok grid), urutan BFS dipotong
+// menjadi k potongan sama besar. Untuk stencil ini menghasilkan "lapisan" yang kompak.
+std::vector<int> bfs_partition(const HostCSR& mat, int num_parts) {
+    int N = mat.num_rows;
+    std::vector<int> order;
+    order.reserve(N);
+    std::vector<char> visited(N, 0);
+
+    std::vector<int> by_degree(N);
+    for(int i=0; i<N; i++) by_degree[i] = i;
+    std::stable_sort(by_degree.begin(), by_degree.end(), [&](int a, int b) {
+        return mat.row_map[a+1] - mat.row_map[a] < mat.row_map[b+1] - mat.row_map[b];
+    });
+
+    for(int start : by_degree) { // Loop untuk graf tidak terhubung
+        if(visited[start]) continue;
+        visited[start] = 1;
+        size_t head = order.size();
+        order.push_back(start);
+        while(head < order.size()) {
+            int u = order[head++];
+            for(int k=mat.row_map[u]; k<mat.row_map[u+1]; k++) {
+                int v = mat.col_idx[k];
+                if(!visited[v]) {
+                    visited[v] = 1;
+                    order.push_back(v);
+                }
+            }
+        }
+    }
+
+    std::vector<int> part(N);
+    for(int pos=0; pos<N; pos++) part[order[pos]] = (int)((long long)pos * num_parts / N);
+    return part;
+}
+
+#ifdef HAVE_METIS
+// METIS tidak boleh menerima self-loop -> buang diagonal dulu.
+bool metis_partition(const HostCSR& mat, int num_parts, std::vector<int>& part) {
+    idx_t n = mat.num_rows;
+    idx_t ncon = 1;
+    idx_t nparts = num_parts;
+    idx_t objval = 0;
+    std::vector<idx_t> xadj(1, 0);
+    std::vector<idx_t> adjncy;
+    for(int i=0; i<mat.num_rows; i++) {
+        for(int k=mat.row_map[i]; k<mat.row_map[i+1]; k++) {
+            if(mat.col_idx[k] != i) adjncy.push_back(mat.col_idx[k]);
+        }
+        xadj.push_back((idx_t)adjncy.size());
+    }
+    std::vector<idx_t> m_part(n);
+    idx_t options[METIS_NOPTIONS];
+    METIS_SetDefaultOptions(options);
+    int status = METIS_PartGraphKway(&n, &ncon, xadj.data(), adjncy.data(), NULL, NULL, NULL,
+                                     &nparts, NULL, NULL, options, &objval, m_part.data());
+    if(status != METIS_OK) return false;
+    part.assign(m_part.begin(), m_part.end());
+    return true;
+}
+#endif
+
+// Renumber: partisi kontigu, interior dulu lalu boundary (urutan relatif asli dipertahankan).
+RowPartition build_row_partition(const HostCSR& mat, const std::vector<int>& part, int num_parts) {
+    int N = mat.num_rows;
+    RowPartition rp;
+    rp.perm.assign(N, -1);
+    rp.part_ptr.assign(num_parts + 1, 0);
+    rp.interior_end.assign(num_parts, 0);
+    rp.cut.assign(num_parts, 0);
+
+    std::vector<char> is_boundary(N, 0);
+    std::vector<int> num_interior(num_parts, 0);
+    for(int i=0; i<N; i++) {
+        for(int k=mat.row_map[i]; k<mat.row_map[i+1]; k++) {
+            if(part[mat.col_idx[k]] != part[i]) {
+                is_boundary[i] = 1;
+                rp.cut[part[i]]++;
+            }
+        }
+        rp.part_ptr[part[i] + 1]++;
+        if(!is_boundary[i]) num_interior[part[i]]++;
+    }
+    for(int p=0; p<num_parts; p++) {
+        rp.part_ptr[p+1] += rp.part_ptr[p];
+        rp.interior_end[p] = rp.part_ptr[p] + num_interior[p];
+    }
+
+    std::vector<int> next_interior(rp.part_ptr.begin(), rp.part_ptr.end() - 1);
+    std::vector<int> next_boundary(rp.interior_end);
+    for(int i=0; i<N; i++) {
+        rp.perm[i] = is_boundary[i] ? next_boundary[part[i]]++ : next_interior[part[i]]++;
+    }
+    return rp;
+}
+
+// Baseline: chunk statis baris kontigu (apa yang dilakukan RangePolicy), tanpa renumbering.
+RowPartition static_chunks(const HostCSR& mat, int num_parts) {
+    int N = mat.num_rows;
+    std::vector<int> part(N);
+    int chunk = (N + num_parts - 1) / num_parts;
+    for(int i=0; i<N; i++) part[i] = i / chunk;
+
+    RowPartition rp;
+    rp.perm.resize(N);
+    for(int i=0; i<N; i++) rp.perm[i] = i;
+    rp.part_ptr.assign(num_parts + 1, N);
+    rp.interior_end.assign(num_parts, 0);
+    rp.cut.assign(num_parts, 0);
+    for(int p=0; p<num_parts; p++) rp.part_ptr[p] = std::min(N, p * chunk);
+    for(int i=0; i<N; i++) {
+        for(int k=mat.row_map[i]; k<mat.row_map[i+1]; k++) {
+            if(part[mat.col_idx[k]] != part[i]) rp.cut[part[i]]++;
+        }
+    }
+    for(int p=0; p<num_parts; p++) rp.interior_end[p] = rp.part_ptr[p]; // Tidak dibedakan
+    return rp;
+}
+
+// --- 3. KERNEL: 1 PARTISI = 1 THREAD (STATIC SCHEDULE) ---
+double benchmark_partitioned(const HostCSR& h_mat, const std::vector<int>& part_ptr, int repeat) {
+    int N = h_mat.num_rows;
+    int NNZ = h_mat.num_nnz;
+    int num_parts = (int)part_ptr.size() - 1;
+
+    Kokkos::View<int*>    row_map("row_map", N + 1);
+    Kokkos::View<int*>    col_idx("col_idx", NNZ);
+    Kokkos::View<double*> values("values", NNZ);
+    Kokkos::View<int*>    parts("part_ptr", num_parts + 1);
+    Kokkos::View<double*> x("x", N);
+    Kokkos::View<double*> y("y", N);
+
+    auto h_row  = Kokkos::create_mirror_view(row_map);
+    auto h_col  = Kokkos::create_mirror_view(col_idx);
+    auto h_val  = Kokkos::create_mirror_view(values);
+    auto h_part = Kokkos::create_mirror_view(parts);
+    for(int i=0; i<=N; i++) h_row(i) = h_mat.row_map[i];
+    for(int k=0; k<NNZ; k++) {
+        h_col(k) = h_mat.col_idx[k];
+        h_val(k) = h_mat.values[k];
+    }
+    for(int p=0; p<=num_parts; p++) h_part(p) = part_ptr[p];
+    Kokkos::deep_copy(row_map, h_row);
+    Kokkos::deep_copy(col_idx, h_col);
+    Kokkos::deep_copy(values, h_val);
+    Kokkos::deep_copy(parts, h_part);
+    Kokkos::deep_copy(x, 1.0);
+
+    // Static + chunk 1: iterasi p selalu jatuh ke thread yang sama setiap launch
+    typedef Kokkos::RangePolicy<Kokkos::Schedule<Kokkos::Static>> static_policy_t;
+    auto kernel = KOKKOS_LAMBDA(const int p) {
+        for (int i = parts(p); i < parts(p+1); i++) {
+            double sum = 0.0;
+            for (int k = row_map(i); k < row_map(i+1); k++) {
+                sum += values(k) * x(col_idx(k));
+            }
+            y(i) = sum;
+        }
+    };
+
+    Kokkos::parallel_for("SpMV_Part_Warmup", static_policy_t(0, num_parts).set_chunk_size(1), kernel);
+    Kokkos::fence();
+    Kokkos::Timer timer;
+    for(int iter=0; iter<repeat; iter++) {
+        Kokkos::parallel_for("SpMV_Partitioned", static_policy_t(0, num_parts).set_chunk_size(1), kernel);
+    }
+    Kokkos::fence();
+    return timer.seconds() / repeat;
+}
+
+// --- 4. REPORT ---
+void print_cut_stats(const RowPartition& rp) {
+    int num_parts = (int)rp.cut.size();
+    long long total = 0;
+    int max_cut = 0;
+    int min_cut = rp.cut.empty() ? 0 : rp.cut[0];
+    for(int c : rp.cut) {
+        total += c;
+        max_cut = std::max(max_cut, c);
+        min_cut = std::min(min_cut, c);
+    }
+    printf("cut min/avg/max = %d / %.0f / %d", min_cut, (double)total / num_parts, max_cut);
+}
+
+int main(int argc, char* argv[]) {
+    Kokkos::initialize(argc, argv);
+    {
+        // Usage: ./11_partitioned_spmv [grid_dim]
+        int grid_dim = argc > 1 ? std::atoi(argv[1]) : 80;
+        int max_threads = Kokkos::DefaultExecutionSpace().concurrency();
+        const int REPEAT = 50;
+
+        printf("=== GRAPH-PARTITIONED ROW DISTRIBUTION (3D STENCIL %d^3) ===\n", grid_dim);
+#ifdef HAVE_METIS
+        printf("Partitioner: METIS_PartGraphKway | Threads: %d\n\n", max_threads);
+#else
+        printf("Partitioner: in-tree BFS fallback (METIS tidak ditemukan) | Threads: %d\n\n", max_threads);
+#endif
+
+        HostCSR natural  = generate_3d_stencil(grid_dim, grid_dim, grid_dim, false);
+        HostCSR shuffled = generate_3d_stencil(grid_dim, grid_dim, grid_dim, true);
+        double flops = 2.0 * shuffled.num_nnz * 1e-9;
+
+        std::vector<int> thread_counts;
+        for(int t=1; t<max_threads; t*=2) thread_counts.push_back(t);
+        thread_counts.push_back(max_threads);
+
+        for(int k : thread_counts) {
+            printf("--- Threads/Partitions: %d ---\n", k);
+
+            RowPartition nat = static_chunks(natural, k);
+            double t_nat = benchmark_partitioned(natural, nat.part_ptr, REPEAT);
+            printf("  Natural  + static chunks : %f s | %6.2f GFLOPs | ", t_nat, flops / t_nat);
+            print_cut_stats(nat);
+            printf("\n");
+
+            RowPartition shf = static_chunks(shuffled, k);
+            double t_shf = benchmark_partitioned(shuffled, shf.part_ptr, REPEAT);
+            printf("  Shuffled + static chunks : %f s | %6.2f GFLOPs | ", t_shf, flops / t_shf);
+            print_cut_stats(shf);
+            printf("\n");
+
+            Kokkos::Timer timer;
+            std::vector<int> part;
+            bool ok = false;
+            if(k == 1) {
+                part.assign(shuffled.num_rows, 0);
+                ok = true;
+            }
+#ifdef HAVE_METIS
+            if(!ok) ok = metis_partition(shuffled, k, part);
+#endif
+            if(!ok) part = bfs_partition(shuffled, k);
+            RowPartition gp = build_row_partition(shuffled, part, k);
+            HostCSR renumbered = permute_matrix(shuffled, gp.perm);
+            double t_setup = timer.seconds();
+
+            double t_gp = benchmark_partitioned(renumbered, gp.part_ptr, REPEAT);
+            printf("  Shuffled + graph parts   : %f s | %6.2f GFLOPs | ", t_gp, flops / t_gp);
+            print_cut_stats(gp);
+            printf(" | setup %.3f s\n", t_setup);
+
+            if(k == max_threads) {
+                printf("  Per-thread (graph parts): rows / boundary rows / cut\n");
+                for(int p=0; p<k; p++) {
+                    printf("    T%-3d %8d / %8d / %8d\n", p, gp.part_ptr[p+1] - gp.part_ptr[p],
+                           gp.part_ptr[p+1] - gp.interior_end[p], gp.cut[p]);
+                }
+            }
+        }
+    }
+    Kokkos::finalize();
+    return 0;
+}
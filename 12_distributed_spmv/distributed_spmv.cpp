@@ -0,0 +1,595 @@
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Timer.hpp>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <new>
+#include <cstdio>
+#include <cstdlib>
+#include <cerrno>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+
+// MODUL 12: DOMAIN-DECOMPOSED SPMV MULTI-PROSES + HALO EXCHANGE (POSIX SHARED MEMORY)
+// Semua modul sebelumnya mengasumsikan satu address space. Di produksi grid 3D dibagi ke banyak rank,
+// dan waktu habis di halo exchange. Modul ini mensimulasikannya di SATU mesin Linux:
+//   - Matriks stencil dibagi per baris (slab kontigu) ke P proses (fork).
+//   - Tiap rank memisahkan kolom LOKAL (milik sendiri) dan kolom GHOST (milik rank lain).
+//   - Send/recv index list dibangun sekali; halo ditukar lewat segmen shm_open yang di-mmap.
+//   - Overlap: publish halo -> SpMV bagian lokal -> tunggu tetangga -> unpack -> SpMV bagian ghost.
+// Laporan: strong scaling (grid tetap) dan weak scaling (grid per rank tetap) untuk 1..N proses.
+//
+// PENTING: Kokkos::initialize dipanggil di tiap proses anak SETELAH fork, bukan di parent
+// (runtime thread OpenMP/Cuda tidak aman untuk di-fork).
+// Kalau satu rank mati/macet, tetangganya tidak boleh spin selamanya: semua spin-wait cek flag
+// abort di shm + timeout, dan parent membunuh rank sisa begitu ada anak yang exit non-zero.
+
+// --- 1. DATA STRUCTURES (HOST SIDE) ---
+struct HostCSR {
+    int num_rows;
+    int num_nnz;
+    std::vector<int> row_map;
+    std::vector<int> col_idx;
+    std::vector<double> values;
+};
+
+// Rencana komunikasi + matriks lokal satu rank (dibangun parent sebelum fork,
+// anak mewarisinya lewat copy-on-write).
+struct HaloPlan {
+    int row_begin, row_end;
+    // Bagian lokal: semua baris milik rank, hanya kolom lokal (indeks lokal)
+    std::vector<int> loc_row_map, loc_col;
+    std::vector<double> loc_val;
+    // Bagian ghost: hanya baris boundary, kolom = slot ghost
+    std::vector<int> bnd_rows, gh_row_map, gh_col;
+    std::vector<double> gh_val;
+    std::vector<int> ghosts;          // Global ID ghost (urut naik)
+    // Recv: ghost dari tetangga recv_nbr[n] ada di slot [recv_ptr[n], recv_ptr[n+1])
+    std::vector<int> recv_nbr, recv_ptr;
+    std::vector<long long> recv_remote; // Offset data untuk saya di outbox tetangga (dalam satu slot halo)
+    // Send: baris lokal send_idx[send_ptr[n] .. send_ptr[n+1]) untuk tetangga send_nbr[n]
+    std::vector<int> send_nbr, send_ptr, send_idx;
+    long long outbox_base;              // Posisi outbox rank ini dalam satu slot halo
+};
+
+struct RankTiming {
+    double total, pack, local, wait, unpack, ghost;
+};
+
+const int MAX_PROCS = 256;
+const double SPIN_TIMEOUT = 60.0; // Detik; jauh di atas satu iterasi halo, hanya untuk rank macet
+
+struct alignas(64) ShmCounter {
+    std::atomic<long long> value;
+};
+
+// Layout segmen shm: [header][halo slot 0][halo slot 1][y global]
+struct ShmHeader {
+    pthread_barrier_t barrier;
+    std::atomic<int> abort;            // != 0 -> ada rank gagal, semua spin-wait berhenti
+    ShmCounter ready[MAX_PROCS];       // ready[r] = it+1 -> outbox iterasi 'it' milik r siap dibaca
+    RankTiming timing[MAX_PROCS][2];   // [rank][0 = tanpa overlap, 1 = overlap]
+};
+
+struct SharedSegment {
+    ShmHeader* header;
+    double* halo;      // 2 slot (double buffering) x total_send
+    double* y;         // Hasil global untuk verifikasi di parent
+    long long total_send;
+    size_t bytes;
+};
+
+// --- 2. GENERATOR STENCIL 3D (NATURAL ORDER, LAPLACIAN) ---
+HostCSR generate_3d_stencil(int nx, int ny, int nz) {
+    HostCSR mat;
+    mat.num_rows = nx * ny * nz;
+    mat.row_map.push_back(0);
+
+    auto get_idx = [&](int x, int y, int z) { return x + y*nx + z*nx*ny; };
+
+    for(int z=0; z<nz; z++) {
+        for(int y=0; y<ny; y++) {
+            for(int x=0; x<nx; x++) {
+                int u = get_idx(x,y,z);
+                auto push = [&](int col, double val) {
+                    mat.col_idx.push_back(col);
+                    mat.values.push_back(val);
+                };
+                if(z>0)    push(get_idx(x, y, z-1), -1.0);
+                if(y>0)    push(get_idx(x, y-1, z), -1.0);
+                if(x>0)    push(get_idx(x-1, y, z), -1.0);
+                push(u, 6.0);
+                if(x<nx-1) push(get_idx(x+1, y, z), -1.0);
+                if(y<ny-1) push(get_idx(x, y+1, z), -1.0);
+                if(z<nz-1) push(get_idx(x, y, z+1), -1.0);
+                mat.row_map.push_back((int)mat.col_idx.size());
+            }
+        }
+    }
+    mat.num_nnz = (int)mat.col_idx.size();
+    return mat;
+}
+
+double x_value(int global_row) { return 1.0 + (global_row % 7) * 0.25; }
+
+// --- 3. DEKOMPOSISI & HALO PLAN ---
+std::vector<HaloPlan> build_halo_plans(const HostCSR& mat, int nprocs) {
+    int N = mat.num_rows;
+    std::vector<int> row_begin(nprocs + 1);
+    for(int r=0; r<=nprocs; r++) row_begin[r] = (int)((long long)N * r / nprocs);
+    auto owner = [&](int row) {
+        return (int)(std::upper_bound(row_begin.begin(), row_begin.end(), row) - row_begin.begin()) - 1;
+    };
+
+    std::vector<HaloPlan> plans(nprocs);
+    for(int r=0; r<nprocs; r++) {
+        HaloPlan& P = plans[r];
+        P.row_begin = row_begin[r];
+        P.row_end   = row_begin[r+1];
+
+        for(int i=P.row_begin; i<P.row_end; i++) {
+            for(int k=mat.row_map[i]; k<mat.row_map[i+1]; k++) {
+                int j = mat.col_idx[k];
+                if(j < P.row_begin || j >= P.row_end) P.ghosts.push_back(j);
+            }
+        }
+        std::sort(P.ghosts.begin(), P.ghosts.end());
+        P.ghosts.erase(std::unique(P.ghosts.begin(), P.ghosts.end()), P.ghosts.end());
+
+        // Rank memiliki range kontigu naik -> ghost dari satu tetangga membentuk segmen kontigu
+        for(int g=0; g<(int)P.ghosts.size(); g++) {
+            int q = owner(P.ghosts[g]);
+            if(P.recv_nbr.empty() || P.recv_nbr.back() != q) {
+                P.recv_nbr.push_back(q);
+                P.recv_ptr.push_back(g);
+            }
+        }
+        P.recv_ptr.push_back((int)P.ghosts.size());
+
+        P.loc_row_map.push_back(0);
+        P.gh_row_map.push_back(0);
+        for(int i=P.row_begin; i<P.row_end; i++) {
+            bool boundary = false;
+            for(int k=mat.row_map[i]; k<mat.row_map[i+1]; k++) {
+                int j = mat.col_idx[k];
+                if(j >= P.row_begin && j < P.row_end) {
+                    P.loc_col.push_back(j - P.row_begin);
+                    P.loc_val.push_back(mat.values[k]);
+                } else {
+                    int slot = (int)(std::lower_bound(P.ghosts.begin(), P.ghosts.end(), j) - P.ghosts.begin());
+                    P.gh_col.push_back(slot);
+                    P.gh_val.push_back(mat.values[k]);
+                    boundary = true;
+                }
+            }
+            P.loc_row_map.push_back((int)P.loc_col.size());
+            if(boundary) {
+                P.bnd_rows.push_back(i - P.row_begin);
+                P.gh_row_map.push_back((int)P.gh_col.size());
+            }
+        }
+    }
+
+    // Send list r -> q = persis segmen ghost q yang dimiliki r (urutan sama),
+    // jadi tidak bergantung pada simetri struktur matriks.
+    for(int r=0; r<nprocs; r++) plans[r].send_ptr.push_back(0);
+    for(int q=0; q<nprocs; q++) {
+        HaloPlan& Q = plans[q];
+        for(size_t n=0; n<Q.recv_nbr.size(); n++) {
+            HaloPlan& S = plans[Q.recv_nbr[n]];
+            Q.recv_remote.push_back((long long)S.send_idx.size()); // Masih relatif, base ditambah nanti
+            for(int g=Q.recv_ptr[n]; g<Q.recv_ptr[n+1]; g++) S.send_idx.push_back(Q.ghosts[g] - S.row_begin);
+            S.send_nbr.push_back(q);
+            S.send_ptr.push_back((int)S.send_idx.size());
+        }
+    }
+    long long base = 0;
+    for(int r=0; r<nprocs; r++) {
+        plans[r].outbox_base = base;
+        base += (long long)plans[r].send_idx.size();
+    }
+    for(int q=0; q<nprocs; q++) {
+        HaloPlan& Q = plans[q];
+        for(size_t n=0; n<Q.recv_nbr.size(); n++) Q.recv_remote[n] += plans[Q.recv_nbr[n]].outbox_base;
+    }
+    return plans;
+}
+
+// --- 4. SHARED MEMORY SEGMENT ---
+bool create_segment(SharedSegment& seg, int nprocs, long long total_send, int num_rows) {
+    char name[64];
+    snprintf(name, sizeof(name), "/kokkos_halo_%d", (int)getpid());
+
+    size_t header_bytes = (sizeof(ShmHeader) + 63) / 64 * 64;
+    seg.total_send = total_send;
+    seg.bytes = header_bytes + sizeof(double) * (2 * total_send + num_rows);
+
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if(fd < 0) return false;
+    bool ok = ftruncate(fd, (off_t)seg.bytes) == 0;
+    void* ptr = ok ? mmap(NULL, seg.bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+    shm_unlink(name); // Mapping tetap hidup; anak mewarisi lewat fork, nama tidak bocor
+    if(ptr == MAP_FAILED) return false;
+
+    seg.header = new (ptr) ShmHeader;
+    seg.halo = (double*)((char*)ptr + header_bytes);
+    seg.y = seg.halo + 2 * total_send;
+    for(int r=0; r<MAX_PROCS; r++) seg.header->ready[r].value.store(0);
+    seg.header->abort.store(0);
+
+    pthread_barrierattr_t attr;
+    pthread_barrierattr_init(&attr);
+    pthread_barrierattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    pthread_barrier_init(&seg.header->barrier, &attr, nprocs);
+    pthread_barrierattr_destroy(&attr);
+    return true;
+}
+
+void destroy_segment(SharedSegment& seg) {
+    pthread_barrier_destroy(&seg.header->barrier);
+    munmap(seg.header, seg.bytes);
+}
+
+// --- 5. RANK (PROSES ANAK) ---
+template <class T>
+Kokkos::View<T*> upload(const char* label, const std::vector<T>& h) {
+    Kokkos::View<T*> v(label, h.size());
+    auto h_v = Kokkos::create_mirror_view(v);
+    for(size_t i=0; i<h.size(); i++) h_v(i) = h[i];
+    Kokkos::deep_copy(v, h_v);
+    return v;
+}
+
+typedef Kokkos::View<double*, Kokkos::HostSpace, Kokkos::MemoryTraits<Kokkos::Unmanaged>> shm_view_t;
+
+// Semua View device milik satu rank
+struct RankData {
+    Kokkos::View<int*>    loc_row_map, loc_col;
+    Kokkos::View<double*> loc_val;
+    Kokkos::View<int*>    bnd_rows, gh_row_map, gh_col;
+    Kokkos::View<double*> gh_val;
+    Kokkos::View<int*>    send_idx;
+    Kokkos::View<double*> x, y, x_ghost, send_buf;
+    Kokkos::View<double*>::HostMirror h_ghost;
+};
+
+RankData upload_rank(const HaloPlan& P) {
+    RankData d;
+    const int n_local = P.row_end - P.row_begin;
+    d.loc_row_map = upload("loc_row_map", P.loc_row_map);
+    d.loc_col     = upload("loc_col", P.loc_col);
+    d.loc_val     = upload("loc_val", P.loc_val);
+    d.bnd_rows    = upload("bnd_rows", P.bnd_rows);
+    d.gh_row_map  = upload("gh_row_map", P.gh_row_map);
+    d.gh_col      = upload("gh_col", P.gh_col);
+    d.gh_val      = upload("gh_val", P.gh_val);
+    d.send_idx    = upload("send_idx", P.send_idx);
+    d.x        = Kokkos::View<double*>("x_local", n_local);
+    d.y        = Kokkos::View<double*>("y_local", n_local);
+    d.x_ghost  = Kokkos::View<double*>("x_ghost", P.ghosts.size());
+    d.send_buf = Kokkos::View<double*>("send_buf", P.send_idx.size());
+    d.h_ghost  = Kokkos::create_mirror_view(d.x_ghost);
+
+    auto h_x = Kokkos::create_mirror_view(d.x);
+    for(int i=0; i<n_local; i++) h_x(i) = x_value(P.row_begin + i);
+    Kokkos::deep_copy(d.x, h_x);
+    return d;
+}
+
+void pack_halo(const RankData& d) {
+    auto x = d.x;
+    auto send_idx = d.send_idx;
+    auto send_buf = d.send_buf;
+    Kokkos::parallel_for("Halo_Pack", send_idx.extent(0), KOKKOS_LAMBDA(const int k) {
+        send_buf(k) = x(send_idx(k));
+    });
+}
+
+void spmv_local(const RankData& d) {
+    auto row_map = d.loc_row_map;
+    auto col_idx = d.loc_col;
+    auto values  = d.loc_val;
+    auto x = d.x;
+    auto y = d.y;
+    Kokkos::parallel_for("SpMV_Local", y.extent(0), KOKKOS_LAMBDA(const int i) {
+        double sum = 0.0;
+        for (int k = row_map(i); k < row_map(i+1); k++) {
+            sum += values(k) * x(col_idx(k));
+        }
+        y(i) = sum;
+    });
+}
+
+// Kontribusi kolom ghost, hanya untuk baris boundary
+void spmv_ghost(const RankData& d) {
+    auto bnd_rows = d.bnd_rows;
+    auto row_map  = d.gh_row_map;
+    auto col_idx  = d.gh_col;
+    auto values   = d.gh_val;
+    auto x_ghost  = d.x_ghost;
+    auto y = d.y;
+    Kokkos::parallel_for("SpMV_Ghost", bnd_rows.extent(0), KOKKOS_LAMBDA(const int b) {
+        double sum = 0.0;
+        for (int k = row_map(b); k < row_map(b+1); k++) {
+            sum += values(k) * x_ghost(col_idx(k));
+        }
+        y(bnd_rows(b)) += sum;
+    });
+}
+
+// Tunggu sampai ready[q] >= target. false -> rank lain abort, atau timeout (lalu kita yang set abort).
+bool wait_ready(ShmHeader* hdr, int q, long long target) {
+    if(hdr->ready[q].value.load(std::memory_order_acquire) >= target) return true;
+    Kokkos::Timer timer;
+    while(hdr->ready[q].value.load(std::memory_order_acquire) < target) {
+        if(hdr->abort.load(std::memory_order_relaxed)) return false;
+        if(timer.seconds() > SPIN_TIMEOUT) {
+            hdr->abort.store(1);
+            return false;
+        }
+        sched_yield();
+    }
+    return true;
+}
+
+// Satu SpMV terdistribusi. 'it' naik terus -> dipakai sebagai nomor urut publish & parity slot.
+// Return false jika exchange dibatalkan (rank lain gagal/macet).
+bool halo_iteration(int rank, const HaloPlan& P, const RankData& d, const SharedSegment& seg,
+                    long long it, bool overlap, RankTiming& t) {
+    ShmHeader* hdr = seg.header;
+    shm_view_t halo(seg.halo, 2 * seg.total_send);
+    const long long slot = (it % 2) * seg.total_send;
+    const long long n_send = (long long)P.send_idx.size();
+    Kokkos::Timer timer;
+
+    // Double buffering: slot ini terakhir dipakai di iterasi it-2. Pembaca sudah selesai
+    // kalau mereka sudah publish iterasi it-1 (ready >= it).
+    for(int q : P.send_nbr) {
+        if(!wait_ready(hdr, q, it)) return false;
+    }
+
+    // (1) Pack & publish
+    pack_halo(d);
+    Kokkos::fence();
+    if(n_send > 0) {
+        auto outbox = Kokkos::subview(halo, Kokkos::make_pair(slot + P.outbox_base, slot + P.outbox_base + n_send));
+        Kokkos::deep_copy(outbox, d.send_buf);
+    }
+    hdr->ready[rank].value.store(it + 1, std::memory_order_release);
+    t.pack += timer.seconds();
+
+    // (2) Overlap: kerjakan bagian lokal selagi tetangga masih publish
+    if(overlap) {
+        timer.reset();
+        spmv_local(d);
+        Kokkos::fence();
+        t.local += timer.seconds();
+    }
+
+    // (3) Tunggu & unpack halo dari outbox tetangga
+    timer.reset();
+    for(int q : P.recv_nbr) {
+        if(!wait_ready(hdr, q, it + 1)) return false;
+    }
+    t.wait += timer.seconds();
+
+    timer.reset();
+    for(size_t n=0; n<P.recv_nbr.size(); n++) {
+        long long src = slot + P.recv_remote[n];
+        int cnt = P.recv_ptr[n+1] - P.recv_ptr[n];
+        Kokkos::deep_copy(Kokkos::subview(d.h_ghost, Kokkos::make_pair(P.recv_ptr[n], P.recv_ptr[n+1])),
+                          Kokkos::subview(halo, Kokkos::make_pair(src, src + cnt)));
+    }
+    Kokkos::deep_copy(d.x_ghost, d.h_ghost);
+    t.unpack += timer.seconds();
+
+    if(!overlap) {
+        timer.reset();
+        spmv_local(d);
+        Kokkos::fence();
+        t.local += timer.seconds();
+    }
+
+    // (4) Tambahkan kontribusi kolom ghost
+    timer.reset();
+    spmv_ghost(d);
+    Kokkos::fence();
+    t.ghost += timer.seconds();
+    return true;
+}
+
+// Return = exit code proses anak (0 = sukses)
+int run_rank(int rank, const std::vector<HaloPlan>& plans, SharedSegment seg, int threads, int repeat) {
+    Kokkos::initialize(Kokkos::InitializationSettings().set_num_threads(threads));
+    bool ok = true;
+    {
+        const HaloPlan& P = plans[rank];
+        RankData d = upload_rank(P);
+        ShmHeader* hdr = seg.header;
+
+        long long it = 0;
+        for(int mode=0; mode<2; mode++) {
+            bool overlap = mode == 1;
+            RankTiming t = {0, 0, 0, 0, 0, 0};
+            for(int w=0; w<2 && ok; w++) ok = halo_iteration(rank, P, d, seg, it++, overlap, t); // Warmup
+            if(!ok) break;
+            t = {0, 0, 0, 0, 0, 0};
+
+            pthread_barrier_wait(&hdr->barrier); // Rank yang sudah mati -> parent SIGKILL yang menunggu di sini
+            Kokkos::Timer total;
+            for(int iter=0; iter<repeat && ok; iter++) ok = halo_iteration(rank, P, d, seg, it++, overlap, t);
+            if(!ok) break;
+            t.total = total.seconds();
+
+            RankTiming& out = hdr->timing[rank][mode];
+            out.total  = t.total / repeat;
+            out.pack   = t.pack / repeat;
+            out.local  = t.local / repeat;
+            out.wait   = t.wait / repeat;
+            out.unpack = t.unpack / repeat;
+            out.ghost  = t.ghost / repeat;
+        }
+
+        if(ok) {
+            shm_view_t y_out(seg.y + P.row_begin, P.row_end - P.row_begin);
+            Kokkos::deep_copy(y_out, d.y);
+        }
+    }
+    Kokkos::finalize();
+    return ok ? 0 : 1;
+}
+
+// --- 6. DRIVER (PARENT) ---
+struct RunResult {
+    double t_sync, t_overlap; // Rank paling lambat
+    double wait_sync, wait_overlap;
+    long long halo_doubles;
+    double max_err;
+    bool ok;
+};
+
+RunResult run_distributed(const HostCSR& mat, int nprocs, int threads, int repeat) {
+    RunResult res = {0, 0, 0, 0, 0, 0.0, false};
+    std::vector<HaloPlan> plans = build_halo_plans(mat, nprocs);
+    long long total_send = plans.back().outbox_base + (long long)plans.back().send_idx.size();
+
+    SharedSegment seg;
+    if(!create_segment(seg, nprocs, total_send, mat.num_rows)) {
+        printf("[ERROR] shm_open/mmap gagal.\n");
+        return res;
+    }
+
+    res.ok = true;
+    std::vector<pid_t> children; // -1 = sudah di-reap
+    for(int r=0; r<nprocs && res.ok; r++) {
+        pid_t pid = fork();
+        if(pid == 0) _exit(run_rank(r, plans, seg, threads, repeat));
+        if(pid < 0) {
+            printf("[ERROR] fork gagal untuk rank %d.\n", r);
+            res.ok = false;
+        } else {
+            children.push_back(pid);
+        }
+    }
+
+    // Reap dalam urutan selesai (bukan urutan rank): anak pertama yang gagal langsung memicu abort,
+    // rank lain (mungkin tertahan di barrier atau spin) dibunuh agar waitpid tidak menggantung.
+    auto kill_remaining = [&]() {
+        seg.header->abort.store(1);
+        for(pid_t c : children) if(c > 0) kill(c, SIGKILL);
+    };
+    if(!res.ok) kill_remaining();
+    int alive = (int)children.size();
+    while(alive > 0) {
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        if(pid < 0) {
+            if(errno == EINTR) continue;
+            break;
+        }
+        auto c = std::find(children.begin(), children.end(), pid);
+        if(c == children.end()) continue;
+        *c = -1;
+        alive--;
+        if(!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            if(res.ok) {
+                printf("[ERROR] rank %d gagal, rank lain dihentikan.\n", (int)(c - children.begin()));
+                kill_remaining();
+            }
+            res.ok = false;
+        }
+    }
+    if(!res.ok) {
+        destroy_segment(seg);
+        return res;
+    }
+
+    for(int r=0; r<nprocs; r++) {
+        res.t_sync       = std::max(res.t_sync, seg.header->timing[r][0].total);
+        res.t_overlap    = std::max(res.t_overlap, seg.header->timing[r][1].total);
+        res.wait_sync    = std::max(res.wait_sync, seg.header->timing[r][0].wait);
+        res.wait_overlap = std::max(res.wait_overlap, seg.header->timing[r][1].wait);
+    }
+    res.halo_doubles = total_send;
+
+    // Verifikasi terhadap SpMV serial global
+    for(int i=0; i<mat.num_rows; i++) {
+        double sum = 0.0;
+        for(int k=mat.row_map[i]; k<mat.row_map[i+1]; k++) sum += mat.values[k] * x_value(mat.col_idx[k]);
+        double d = sum - seg.y[i];
+        if(d < 0) d = -d;
+        if(d > res.max_err) res.max_err = d;
+    }
+
+    destroy_segment(seg);
+    return res;
+}
+
+void print_row(int nprocs, int threads, const HostCSR& mat, const RunResult& r, double t_ref, bool weak) {
+    if(!r.ok) {
+        printf("%5d | %7d | %9d | %9s | rank gagal, tidak ada timing\n", nprocs, threads, mat.num_rows, "-");
+        return;
+    }
+    double flops = 2.0 * mat.num_nnz * 1e-9;
+    // Strong: E = t1 / (P * tP), Weak: E = t1 / tP (kerja per rank konstan)
+    double eff = weak ? t_ref / r.t_overlap : t_ref / (nprocs * r.t_overlap);
+    printf("%5d | %7d | %9d | %9lld | %10.6f | %6.2f | %10.6f | %6.2f | %9.6f | %9.6f | %5.1f%% | %.1e\n",
+           nprocs, threads, mat.num_rows, r.halo_doubles,
+           r.t_sync, flops / r.t_sync, r.t_overlap, flops / r.t_overlap,
+           r.wait_sync, r.wait_overlap, 100.0 * eff, r.max_err);
+}
+
+int main(int argc, char* argv[]) {
+    // Usage: ./12_distributed_spmv [grid_dim] [max_procs] [weak_slab_z]
+    int hw = (int)std::thread::hardware_concurrency();
+    if(hw < 1) hw = 1;
+    int grid_dim  = argc > 1 ? std::atoi(argv[1]) : 64;
+    int max_procs = argc > 2 ? std::atoi(argv[2]) : hw;
+    int slab_z    = argc > 3 ? std::atoi(argv[3]) : 32;
+    max_procs = std::max(1, std::min(max_procs, MAX_PROCS));
+    const int REPEAT = 50;
+
+    std::vector<int> proc_counts;
+    for(int p=1; p<max_procs; p*=2) proc_counts.push_back(p);
+    proc_counts.push_back(max_procs);
+
+    printf("=== DISTRIBUTED SPMV (POSIX SHM HALO EXCHANGE, %d HW THREADS) ===\n", hw);
+    const char* header = "%5s | %7s | %9s | %9s | %10s | %6s | %10s | %6s | %9s | %9s | %6s | %s\n";
+
+    printf("\n[Strong Scaling] Global grid %d^3, slab decomposition\n", grid_dim);
+    printf(header, "Procs", "Thr/Prc", "Rows", "Halo dbl", "Sync (s)", "GFLOPs", "Overlap(s)", "GFLOPs",
+           "Wait Sync", "Wait Ovl", "Eff", "MaxErr");
+    {
+        HostCSR mat = generate_3d_stencil(grid_dim, grid_dim, grid_dim);
+        double t1 = 0.0;
+        for(int p : proc_counts) {
+            int threads = std::max(1, hw / p);
+            RunResult r = run_distributed(mat, p, threads, REPEAT);
+            if(p == 1) t1 = r.t_overlap;
+            print_row(p, threads, mat, r, t1, false);
+        }
+    }
+
+    printf("\n[Weak Scaling] %d x %d x %d per process\n", grid_dim, grid_dim, slab_z);
+    printf(header, "Procs", "Thr/Prc", "Rows", "Halo dbl", "Sync (s)", "GFLOPs", "Overlap(s)", "GFLOPs",
+           "Wait Sync", "Wait Ovl", "Eff", "MaxErr");
+    {
+        double t1 = 0.0;
+        for(int p : proc_counts) {
+            int threads = std::max(1, hw / p);
+            HostCSR mat = generate_3d_stencil(grid_dim, grid_dim, slab_z * p);
+            RunResult r = run_distributed(mat, p, threads, REPEAT);
+            if(p == 1) t1 = r.t_overlap;
+            print_row(p, threads, mat, r, t1, true);
+        }
+    }
+    printf("\nSync = tunggu halo dulu baru SpMV; Overlap = SpMV lokal selagi halo datang. Wait = max antar rank.\n");
+    return 0;
+}
@@ -0,0 +1,321 @@
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Timer.hpp>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include "kernels.hpp" // axpby, dot (dijaga oleh 15_perf_regression)
+
+// MODUL 13: BLAS-1 KERNEL LIBRARY (FUSED + COMPENSATED DOT)
+// Modul 1 (vector_add) dan 2 (dot_product) masing-masing hanya satu operasi.
+// Di sini: axpby, scal, dot, nrm2, waxpby, update (3 vektor), plus:
+//   - Fusi: beberapa operasi dalam SATU pass memori (mis. langkah CG: x += a*p, r -= a*Ap, r.r).
+//     BLAS-1 bandwidth-bound -> jumlah byte yang dibaca/tulis = waktu.
+//   - Dot terkompensasi & reproducible: vektor dipotong blok berukuran TETAP (tidak tergantung
+//     jumlah thread), kompensasi gaya Kahan di dalam blok (Dot2: TwoProduct + TwoSum, karena error
+//     perkalian x*y juga ikut dikompensasi), lalu partial sum blok digabung pairwise dengan urutan
+//     tetap. Hasil bit-identik untuk berapapun thread.
+// Semua kernel dibandingkan dengan baseline STREAM copy & triad (GB/s).
+// Catatan: jangan compile dengan -ffast-math, compiler boleh menghapus kompensasi Kahan.
+
+typedef Kokkos::View<double*> vec_t;
+
+// --- 1. KERNEL DASAR ---
+// axpby & dot ada di common/kernels.hpp (dipakai bersama 15_perf_regression).
+// x = a*x
+void scal(double a, vec_t x) {
+    Kokkos::parallel_for("BLAS1_scal", x.extent(0), KOKKOS_LAMBDA(const int i) {
+        x(i) = a * x(i);
+    });
+}
+
+double nrm2(vec_t x) {
+    double result = 0.0;
+    Kokkos::parallel_reduce("BLAS1_nrm2", x.extent(0), KOKKOS_LAMBDA(const int i, double& lsum) {
+        lsum += x(i) * x(i);
+    }, result);
+    return std::sqrt(result);
+}
+
+// w = a*x + b*y
+void waxpby(vec_t w, double a, vec_t x, double b, vec_t y) {
+    Kokkos::parallel_for("BLAS1_waxpby", w.extent(0), KOKKOS_LAMBDA(const int i) {
+        w(i) = a * x(i) + b * y(i);
+    });
+}
+
+// z = a*x + b*y + c*z (seperti KokkosBlas::update)
+void update(double a, vec_t x, double b, vec_t y, double c, vec_t z) {
+    Kokkos::parallel_for("BLAS1_update", z.extent(0), KOKKOS_LAMBDA(const int i) {
+        z(i) = a * x(i) + b * y(i) + c * z(i);
+    });
+}
+
+// --- 2. FUSI ---
+// Satu pass generik: op(i) boleh menulis vektor apa saja dan mengembalikan kontribusi reduksi.
+// Dengan ini beberapa operasi elemen-wise + satu dot digabung jadi satu kernel.
+template <class ElementOp>
+double fused_reduce(const char* label, int n, ElementOp op) {
+    double result = 0.0;
+    Kokkos::parallel_reduce(label, n, KOKKOS_LAMBDA(const int i, double& lsum) {
+        lsum += op(i);
+    }, result);
+    return result;
+}
+
+// Langkah CG: x += alpha*p ; r -= alpha*Ap ; return r.r
+// Unfused: axpby + axpby + dot = 3 kernel, baca r dua kali.
+// Fused  : 1 kernel (baca x, p, r, Ap; tulis x, r).
+double fused_cg_update(double alpha, vec_t p, vec_t Ap, vec_t x, vec_t r) {
+    return fused_reduce("BLAS1_fused_cg", (int)x.extent(0), KOKKOS_LAMBDA(const int i) {
+        x(i) += alpha * p(i);
+        const double ri = r(i) - alpha * Ap(i);
+        r(i) = ri;
+        return ri * ri;
+    });
+}
+
+// w = a*x + b*y ; return w.w (waxpby + nrm2^2 dalam satu pass)
+double fused_waxpby_dot(vec_t w, double a, vec_t x, double b, vec_t y) {
+    return fused_reduce("BLAS1_fused_waxpby_dot", (int)w.extent(0), KOKKOS_LAMBDA(const int i) {
+        const double wi = a * x(i) + b * y(i);
+        w(i) = wi;
+        return wi * wi;
+    });
+}
+
+// --- 3. COMPENSATED & REPRODUCIBLE DOT ---
+// Partial sum per blok tetap (Dot2, Ogita-Rump-Oishi) -> pasangan (hi, lo) per blok -> penggabungan
+// pairwise di host dengan urutan tetap. Urutan operasi floating point TIDAK bergantung pada jumlah thread.
+// Kompensasi dibawa sampai akhir: blok TIDAK dibulatkan ke satu double (partial blok bisa jauh lebih
+// besar dari hasil akhir saat terjadi cancellation, error pembulatannya akan mendominasi),
+// dan tree menggabungkan (hi, lo) dengan TwoSum.
+const int DOT_BLOCK = 4096;
+
+// TwoSum: s + e == a + b secara eksak
+inline void two_sum(double a, double b, double& s, double& e) {
+    s = a + b;
+    const double z = s - a;
+    e = (a - (s - z)) + (b - z);
+}
+
+// Workspace dialokasikan sekali per ukuran vektor: View partial (device), mirror host, buffer tree.
+// Tanpa ini tiap panggilan alokasi + zero-fill 2 View, dan waktunya ikut terukur sebagai "kernel".
+struct DotWorkspace {
+    Kokkos::View<double*> partials_hi;
+    Kokkos::View<double*> partials_lo;
+    Kokkos::View<double*>::HostMirror h_hi;
+    Kokkos::View<double*>::HostMirror h_lo;
+    std::vector<double> tree_hi;
+    std::vector<double> tree_lo;
+};
+
+DotWorkspace make_dot_workspace(int n) {
+    const int num_blocks = (n + DOT_BLOCK - 1) / DOT_BLOCK;
+    DotWorkspace ws;
+    ws.partials_hi = Kokkos::View<double*>("dot_partials_hi", num_blocks);
+    ws.partials_lo = Kokkos::View<double*>("dot_partials_lo", num_blocks);
+    ws.h_hi = Kokkos::create_mirror_view(ws.partials_hi);
+    ws.h_lo = Kokkos::create_mirror_view(ws.partials_lo);
+    ws.tree_hi.reserve(num_blocks);
+    ws.tree_lo.reserve(num_blocks);
+    return ws;
+}
+
+// Bagian device: satu pasangan (hi, lo) per blok
+void dot_compensated_blocks(vec_t x, vec_t y, DotWorkspace& ws) {
+    const int n = (int)x.extent(0);
+    auto partials_hi = ws.partials_hi;
+    auto partials_lo = ws.partials_lo;
+
+    Kokkos::parallel_for("BLAS1_dot2_blocks", partials_hi.extent(0), KOKKOS_LAMBDA(const int b) {
+        const int begin = b * DOT_BLOCK;
+        const int end   = begin + DOT_BLOCK < n ? begin + DOT_BLOCK : n;
+        double sum = 0.0;
+        double c = 0.0; // Kompensasi: error perkalian + error penjumlahan yang hilang
+        for (int i = begin; i < end; i++) {
+            const double p  = x(i) * y(i);
+            const double ep = Kokkos::fma(x(i), y(i), -p); // TwoProduct: error pembulatan x*y (eksak)
+            const double t  = sum + p;
+            const double z  = t - sum;
+            const double es = (sum - (t - z)) + (p - z);   // TwoSum: error pembulatan sum + p (eksak)
+            sum = t;
+            c += ep + es;
+        }
+        partials_hi(b) = sum;
+        partials_lo(b) = c;
+    });
+}
+
+// Bagian host: copy partial + pairwise tree (error O(log n) vs O(n) untuk penjumlahan berurutan),
+// hi digabung dengan TwoSum, errornya + lo kedua anak masuk ke lo.
+double dot_compensated_tree(DotWorkspace& ws) {
+    Kokkos::deep_copy(ws.h_hi, ws.partials_hi);
+    Kokkos::deep_copy(ws.h_lo, ws.partials_lo);
+    const size_t num_blocks = ws.h_hi.extent(0);
+
+    std::vector<double>& hi = ws.tree_hi;
+    std::vector<double>& lo = ws.tree_lo;
+    hi.assign(ws.h_hi.data(), ws.h_hi.data() + num_blocks);
+    lo.assign(ws.h_lo.data(), ws.h_lo.data() + num_blocks);
+    while(hi.size() > 1) {
+        size_t half = (hi.size() + 1) / 2;
+        for(size_t i=0; i<hi.size() / 2; i++) {
+            double s, e;
+            two_sum(hi[2*i], hi[2*i+1], s, e);
+            hi[i] = s;
+            lo[i] = lo[2*i] + lo[2*i+1] + e;
+        }
+        if(hi.size() % 2) {
+            hi[half - 1] = hi.back();
+            lo[half - 1] = lo.back();
+        }
+        hi.resize(half);
+        lo.resize(half);
+    }
+    return hi.empty() ? 0.0 : hi[0] + lo[0];
+}
+
+double dot_compensated(vec_t x, vec_t y, DotWorkspace& ws) {
+    dot_compensated_blocks(x, y, ws);
+    return dot_compensated_tree(ws);
+}
+
+// --- 4. STREAM BASELINE ---
+void stream_copy(vec_t a, vec_t c) {
+    Kokkos::parallel_for("STREAM_copy", c.extent(0), KOKKOS_LAMBDA(const int i) {
+        c(i) = a(i);
+    });
+}
+
+void stream_triad(vec_t a, vec_t b, double s, vec_t c) {
+    Kokkos::parallel_for("STREAM_triad", a.extent(0), KOKKOS_LAMBDA(const int i) {
+        a(i) = b(i) + s * c(i);
+    });
+}
+
+// --- 5. BENCHMARK ---
+template <class Func>
+double time_kernel(Func f, int repeat) {
+    f(); // Warmup
+    Kokkos::fence();
+    Kokkos::Timer timer;
+    for(int iter=0; iter<repeat; iter++) f();
+    Kokkos::fence();
+    return timer.seconds() / repeat;
+}
+
+void report(const char* name, double t, double doubles_moved, double n, double gbs_triad) {
+    double gbs = doubles_moved * n * sizeof(double) * 1e-9 / t;
+    if(gbs_triad > 0) printf("%-24s | %10.6f | %8.2f | %6.1f%%\n", name, t, gbs, 100.0 * gbs / gbs_triad);
+    else              printf("%-24s | %10.6f | %8.2f |\n", name, t, gbs);
+}
+
+// Simulasi "P thread" di host: P chunk dijumlah berurutan lalu digabung.
+// Menunjukkan bahwa hasil dot biasa berubah bila pembagian kerja berubah.
+double dot_chunked_host(const std::vector<double>& x, const std::vector<double>& y, int parts) {
+    size_t n = x.size();
+    double total = 0.0;
+    for(int p=0; p<parts; p++) {
+        size_t begin = n * p / parts;
+        size_t end = n * (p + 1) / parts;
+        double sum = 0.0;
+        for(size_t i=begin; i<end; i++) sum += x[i] * y[i];
+        total += sum;
+    }
+    return total;
+}
+
+int main(int argc, char* argv[]) {
+    Kokkos::initialize(argc, argv);
+    {
+        // Usage: ./13_blas1 [log2_n]
+        int log2_n = argc > 1 ? std::atoi(argv[1]) : 24;
+        const int N = 1 << log2_n;
+        const int REPEAT = 20;
+        printf("=== KOKKOS BLAS-1 (N = 2^%d = %d, %.0f MB per vector) ===\n\n", log2_n, N, N * 8.0 / 1e6);
+
+        vec_t a("a", N), b("b", N), c("c", N), x("x", N), y("y", N), z("z", N), w("w", N);
+        Kokkos::deep_copy(a, 1.0);
+        Kokkos::deep_copy(b, 2.0);
+        Kokkos::deep_copy(c, 0.5);
+        Kokkos::deep_copy(x, 1.0);
+        Kokkos::deep_copy(y, 0.5);
+        Kokkos::deep_copy(z, 0.25);
+
+        DotWorkspace dot_ws = make_dot_workspace(N);
+        double sink = 0.0; // Hasil reduksi dipakai -> tidak bisa dieliminasi compiler
+
+        printf("%-24s | %10s | %8s | %s\n", "Kernel", "Time (s)", "GB/s", "% Triad");
+
+        // Baseline STREAM (kolom ketiga = double yang dibaca + ditulis per elemen)
+        double t_copy  = time_kernel([&]() { stream_copy(a, c); }, REPEAT);
+        double t_triad = time_kernel([&]() { stream_triad(a, b, 3.0, c); }, REPEAT);
+        double gbs_triad = 3.0 * N * sizeof(double) * 1e-9 / t_triad;
+        report("STREAM copy", t_copy, 2, N, 0);
+        report("STREAM triad", t_triad, 3, N, 0);
+        printf("-------------------------+------------+----------+--------\n");
+
+        // Koefisien dipilih agar nilai tetap terbatas setelah banyak repeat
+        report("axpby",  time_kernel([&]() { axpby(0.5, x, 0.5, y); }, REPEAT), 3, N, gbs_triad);
+        report("scal",   time_kernel([&]() { scal(1.0, z); }, REPEAT), 2, N, gbs_triad);
+        report("dot",    time_kernel([&]() { sink += dot(x, y); }, REPEAT), 2, N, gbs_triad);
+        // Compensated: kernel blok (device) dilaporkan sebagai GB/s, tree di host terpisah
+        report("dot (compensated)", time_kernel([&]() { dot_compensated_blocks(x, y, dot_ws); }, REPEAT), 2, N, gbs_triad);
+        double t_tree = time_kernel([&]() { sink += dot_compensated_tree(dot_ws); }, REPEAT);
+        char tree_label[32];
+        snprintf(tree_label, sizeof(tree_label), "  + host tree (%d blok)", (int)dot_ws.partials_hi.extent(0));
+        printf("%-24s | %10.6f |          | (copy partial D->H + pairwise TwoSum)\n", tree_label, t_tree);
+        report("nrm2",   time_kernel([&]() { sink += nrm2(x); }, REPEAT), 1, N, gbs_triad);
+        report("waxpby", time_kernel([&]() { waxpby(w, 0.5, x, 0.5, y); }, REPEAT), 3, N, gbs_triad);
+        report("update (3 vec)", time_kernel([&]() { update(0.25, x, 0.25, y, 0.5, z); }, REPEAT), 4, N, gbs_triad);
+        printf("-------------------------+------------+----------+--------\n");
+
+        // Fusi: langkah CG. alpha = 0 supaya nilai tidak meledak, trafik memori tetap sama.
+        // Unfused: axpby(3) + axpby(3) + dot(1, r.r) = 7 double / elemen. Fused: 4 baca + 2 tulis = 6.
+        double t_cg_unfused = time_kernel([&]() {
+            axpby(0.0, y, 1.0, x);
+            axpby(0.0, z, 1.0, w);
+            sink += dot(w, w);
+        }, REPEAT);
+        double t_cg_fused = time_kernel([&]() { sink += fused_cg_update(0.0, y, z, x, w); }, REPEAT);
+        report("CG step (3 kernels)", t_cg_unfused, 7, N, gbs_triad);
+        report("CG step (fused)", t_cg_fused, 6, N, gbs_triad);
+        printf("  -> Fused speedup: %.2fx\n", t_cg_unfused / t_cg_fused);
+
+        double t_wd_unfused = time_kernel([&]() { waxpby(w, 0.5, x, 0.5, y); sink += dot(w, w); }, REPEAT);
+        double t_wd_fused   = time_kernel([&]() { sink += fused_waxpby_dot(w, 0.5, x, 0.5, y); }, REPEAT);
+        report("waxpby + dot (2 kern)", t_wd_unfused, 4, N, gbs_triad);
+        report("waxpby + dot (fused)", t_wd_fused, 3, N, gbs_triad);
+        printf("  -> Fused speedup: %.2fx\n\n", t_wd_unfused / t_wd_fused);
+        if(sink == 42.0) printf(" "); // Cegah reduksi dieliminasi compiler
+
+        // --- REPRODUCIBILITY ---
+        // Data dengan magnitudo campur (cancellation) agar perbedaan urutan terlihat.
+        auto h_x = Kokkos::create_mirror_view(x);
+        auto h_y = Kokkos::create_mirror_view(y);
+        std::vector<double> vx(N), vy(N);
+        for(int i=0; i<N; i++) {
+            vx[i] = (i % 2 ? 1.0 : -1.0) * (1.0 + 1e8 * ((i * 7919) % 13 == 0)) + 1e-3 * (i % 101);
+            vy[i] = 1.0 + 1e-9 * (i % 997);
+            h_x(i) = vx[i];
+            h_y(i) = vy[i];
+        }
+        Kokkos::deep_copy(x, h_x);
+        Kokkos::deep_copy(y, h_y);
+
+        long double ref = 0.0L;
+        for(int i=0; i<N; i++) ref += (long double)vx[i] * vy[i];
+
+        printf("Reproducibility (reference long double = %.17Lg)\n", ref);
+        printf("  dot (parallel_reduce) : %.17g\n", dot(x, y));
+        printf("  dot (compensated)     : %.17g\n", dot_compensated(x, y, dot_ws));
+        printf("  Naive sum, simulated thread counts:\n");
+        for(int parts=1; parts<=64; parts*=4) {
+            printf("    %2d chunks           : %.17g\n", parts, dot_chunked_host(vx, vy, parts));
+        }
+        printf("  (Jalankan ulang dengan --kokkos-num-threads=K: nilai compensated harus identik.)\n");
+    }
+    Kokkos::finalize();
+    return 0;
+}
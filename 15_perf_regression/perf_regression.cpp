@@ -0,0 +1,428 @@
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Timer.hpp>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "host_csr.hpp" // HostCSR, generate_3d_stencil
+#include "kernels.hpp" // Kernel yang dijaga: spmv_csr, spmv_csr_team, axpby, dot
+
+// MODUL 15: PERFORMANCE REGRESSION SUITE (CTEST + BASELINE PER HOST)
+// Tabel di README mencampur angka CPU & GPU dari mesin berbeda -> tidak bisa dipakai untuk
+// mendeteksi regresi. Di sini: set matriks TETAP (ukuran sedang, seed tetap) dijalankan lewat
+// kernel dari common/kernels.hpp, yaitu kode yang SAMA dengan yang dipakai 05_reordering (spmv_csr),
+// 06_gpu_preparation (spmv_csr_team) dan 13_blas1 (axpby, dot). Mengubah kernel di sana = terukur di sini.
+// Tiap kernel diukur beberapa sampel, diambil MEDIAN (tahan terhadap outlier/noise OS). Median
+// diulang --runs kali dan diambil yang TERKECIL (noise hanya bisa memperlambat), untuk baseline
+// maupun run pembanding. Hasilnya dibandingkan dengan baseline JSON milik host ini:
+//   <baseline-dir>/<hostname>-<backend>-<threads>.json
+// Backend & jumlah thread masuk ke nama file: angka OpenMP 8 thread tidak dibandingkan dengan
+// 16 thread atau CUDA.
+//   - Baseline belum ada           -> hasil run ini jadi baseline, test lulus.
+//   - Kernel/matriks baru          -> entrinya ditambahkan ke baseline yang ada (langsung dijaga).
+//   - File ada tapi 0 entri terbaca -> GAGAL (baseline rusak/kosong tidak boleh selalu lulus).
+//   - median > baseline * (1 + threshold) -> kernel itu diukur ulang (--retries kali); hanya jika
+//                                    TETAP lambat -> REGRESSION, exit code 1 (ctest gagal).
+//   - --update                     -> baseline ditimpa (setelah perubahan yang memang disengaja).
+// Ringkasan ditulis sebagai tabel Markdown (--summary FILE), juga dicetak ke stdout.
+//
+// Usage: ./15_perf_regression [--baseline-dir DIR] [--threshold 0.10] [--summary FILE.md]
+//                             [--samples K] [--runs K] [--retries R] [--update]
+
+// --- 1. SET MATRIKS TETAP ---
+// Laplacian 7-point (Natural or Shuffled): generate_3d_stencil dari common/host_csr.hpp
+// Random uniform (seperti Modul 4, tapi lebih ringan): nnz per baris di [min_nnz, max_nnz)
+HostCSR generate_random_csr(int rows, int min_nnz, int max_nnz, unsigned seed) {
+    HostCSR mat;
+    mat.num_rows = rows;
+    mat.row_map.push_back(0);
+
+    std::mt19937 rng(seed); // Seed tetap agar reproducible
+    std::uniform_int_distribution<int> dist_col(0, rows - 1);
+    std::uniform_int_distribution<int> dist_len(min_nnz, max_nnz - 1);
+    std::uniform_real_distribution<double> dist_val(0.0, 10.0);
+
+    std::vector<int> cols;
+    for(int i=0; i<rows; i++) {
+        int row_nnz = dist_len(rng);
+        cols.clear();
+        while((int)cols.size() < row_nnz) cols.push_back(dist_col(rng));
+        std::sort(cols.begin(), cols.end()); // CSR wajib urut kolomnya
+        cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+        for(int c : cols) {
+            mat.col_idx.push_back(c);
+            mat.values.push_back(dist_val(rng));
+        }
+        mat.row_map.push_back((int)mat.col_idx.size());
+    }
+    mat.num_nnz = (int)mat.col_idx.size();
+    return mat;
+}
+
+// Power-law (mirip graf web/sosial): panjang baris berdistribusi Pareto -> sedikit baris sangat
+// panjang (load imbalance, di sini TeamPolicy seharusnya menang), kolom terkonsentrasi di indeks
+// kecil (hub: x(hub) dibaca berulang).
+HostCSR generate_powerlaw_csr(int rows, double alpha, unsigned seed) {
+    HostCSR mat;
+    mat.num_rows = rows;
+    mat.row_map.push_back(0);
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uni(1e-12, 1.0);
+    std::uniform_real_distribution<double> dist_val(0.0, 10.0);
+    const int max_len = rows / 20;
+
+    std::vector<int> cols;
+    for(int i=0; i<rows; i++) {
+        int row_nnz = (int)(2.0 * std::pow(uni(rng), -1.0 / alpha));
+        row_nnz = std::max(1, std::min(row_nnz, max_len));
+        cols.clear();
+        for(int k=0; k<row_nnz; k++) cols.push_back((int)(rows * std::pow(uni(rng), 3.0)) % rows);
+        std::sort(cols.begin(), cols.end());
+        cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+        for(int c : cols) {
+            mat.col_idx.push_back(c);
+            mat.values.push_back(dist_val(rng));
+        }
+        mat.row_map.push_back((int)mat.col_idx.size());
+    }
+    mat.num_nnz = (int)mat.col_idx.size();
+    return mat;
+}
+
+// --- 2. DEVICE CSR ---
+struct DeviceCSR {
+    Kokkos::View<int*>    row_map;
+    Kokkos::View<int*>    col_idx;
+    Kokkos::View<double*> values;
+    int num_rows;
+    int num_nnz;
+};
+
+DeviceCSR upload(const HostCSR& h) {
+    DeviceCSR A;
+    A.num_rows = h.num_rows;
+    A.num_nnz  = h.num_nnz;
+    A.row_map  = Kokkos::View<int*>("row_map", h.num_rows + 1);
+    A.col_idx  = Kokkos::View<int*>("col_idx", h.num_nnz);
+    A.values   = Kokkos::View<double*>("values", h.num_nnz);
+
+    auto h_row = Kokkos::create_mirror_view(A.row_map);
+    auto h_col = Kokkos::create_mirror_view(A.col_idx);
+    auto h_val = Kokkos::create_mirror_view(A.values);
+    for(int i=0; i<=h.num_rows; i++) h_row(i) = h.row_map[i];
+    for(int k=0; k<h.num_nnz; k++) {
+        h_col(k) = h.col_idx[k];
+        h_val(k) = h.values[k];
+    }
+    Kokkos::deep_copy(A.row_map, h_row);
+    Kokkos::deep_copy(A.col_idx, h_col);
+    Kokkos::deep_copy(A.values, h_val);
+    return A;
+}
+
+// --- 3. PENGUKURAN: MEDIAN DARI K SAMPEL ---
+// Tiap sampel = rata-rata 'iters' panggilan (sampel terlalu pendek didominasi overhead launch/timer).
+template <class Func>
+double median_time(Func f, int samples, int iters) {
+    for(int w=0; w<3; w++) f(); // Warmup (first touch, cache, JIT GPU)
+    Kokkos::fence();
+    std::vector<double> t(samples);
+    for(int s=0; s<samples; s++) {
+        Kokkos::Timer timer;
+        for(int iter=0; iter<iters; iter++) f();
+        Kokkos::fence();
+        t[s] = timer.seconds() / iters;
+    }
+    std::sort(t.begin(), t.end());
+    return samples % 2 ? t[samples / 2] : 0.5 * (t[samples / 2 - 1] + t[samples / 2]);
+}
+
+// Min dari median 'runs' kali pengukuran: spike sesaat (OS, turbo, proses lain) tidak masuk baseline.
+template <class Func>
+double best_median(Func f, int runs, int samples, int iters) {
+    double best = median_time(f, samples, iters);
+    for(int r=1; r<runs; r++) best = std::min(best, median_time(f, samples, iters));
+    return best;
+}
+
+// Kernel terdaftar: disimpan agar bisa diukur ulang saat dicurigai regresi.
+struct Bench {
+    std::string name;           // "matrix/kernel"
+    double work;                // GFLOP per panggilan (kolom GFLOPs)
+    std::function<void()> run;
+};
+
+struct Result {
+    std::string name;   // "matrix/kernel"
+    double median;      // Detik per panggilan
+    double gflops;
+    double baseline;    // < 0 -> belum ada di baseline
+};
+
+// --- 4. BASELINE JSON ---
+// Format sengaja sederhana (satu entri per baris) supaya diff di git terbaca & parser cukup kecil:
+// { "host": "...", "backend": "...", "threads": 8,
+//   "entries": [ { "name": "stencil_natural/spmv_range", "median_s": 1.234e-04 }, ... ] }
+std::string host_name() {
+    char buf[256] = {0};
+    if(gethostname(buf, sizeof(buf) - 1) != 0 || buf[0] == '\0') return "unknown";
+    for(char* p = buf; *p; p++) {
+        if(*p == '/' || *p == ' ') *p = '_';
+    }
+    return buf;
+}
+
+// Return false jika file tidak ada. Entri dengan median tidak valid dilewati.
+bool load_baseline(const std::string& path, std::vector<Result>& entries) {
+    std::ifstream in(path);
+    if(!in) return false;
+    std::stringstream ss;
+    ss << in.rdbuf();
+    const std::string text = ss.str();
+    const std::string key_name = "\"name\"";
+    const std::string key_med  = "\"median_s\"";
+
+    size_t pos = 0;
+    while((pos = text.find(key_name, pos)) != std::string::npos) {
+        size_t colon = text.find(':', pos + key_name.size());
+        size_t q0 = colon == std::string::npos ? colon : text.find('"', colon + 1);
+        size_t q1 = q0 == std::string::npos ? q0 : text.find('"', q0 + 1);
+        size_t m  = q1 == std::string::npos ? q1 : text.find(key_med, q1);
+        size_t mc = m == std::string::npos ? m : text.find(':', m + key_med.size());
+        if(mc == std::string::npos) break;
+
+        const char* begin = text.c_str() + mc + 1;
+        char* end = nullptr;
+        double median = std::strtod(begin, &end);
+        if(end != begin && median > 0.0 && std::isfinite(median)) {
+            Result r = {text.substr(q0 + 1, q1 - q0 - 1), median, 0.0, -1.0};
+            entries.push_back(r);
+        }
+        pos = mc;
+    }
+    return true;
+}
+
+bool write_baseline(const std::string& path, const std::string& host, const std::string& backend,
+                    int threads, const std::vector<Result>& entries) {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if(!f) return false;
+    fprintf(f, "{\n  \"host\": \"%s\",\n  \"backend\": \"%s\",\n  \"threads\": %d,\n  \"entries\": [\n",
+            host.c_str(), backend.c_str(), threads);
+    for(size_t i=0; i<entries.size(); i++) {
+        fprintf(f, "    { \"name\": \"%s\", \"median_s\": %.6e }%s\n", entries[i].name.c_str(),
+                entries[i].median, i + 1 < entries.size() ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    return std::fclose(f) == 0;
+}
+
+// --- 5. RINGKASAN MARKDOWN ---
+bool is_regression(const Result& r, double threshold) {
+    return r.baseline > 0.0 && r.median > r.baseline * (1.0 + threshold);
+}
+
+const char* status_of(const Result& r, double threshold) {
+    if(r.baseline <= 0.0) return "new";
+    if(is_regression(r, threshold)) return "**REGRESSION**";
+    if(r.median < r.baseline * (1.0 - threshold)) return "faster";
+    return "ok";
+}
+
+void write_summary(FILE* f, const std::string& baseline_path, double threshold, const std::vector<Result>& results) {
+    fprintf(f, "## Performance regression summary\n\n");
+    fprintf(f, "Baseline: `%s` (threshold %.1f%%)\n\n", baseline_path.c_str(), 100.0 * threshold);
+    fprintf(f, "| Matrix | Kernel | Baseline (ms) | Median (ms) | Change | GFLOPs | Status |\n");
+    fprintf(f, "|---|---|---:|---:|---:|---:|---|\n");
+    for(const Result& r : results) {
+        size_t slash = r.name.find('/');
+        std::string matrix = r.name.substr(0, slash);
+        std::string kernel = r.name.substr(slash + 1);
+        if(r.baseline > 0.0) {
+            fprintf(f, "| %s | %s | %.4f | %.4f | %+.1f%% | %.2f | %s |\n", matrix.c_str(), kernel.c_str(),
+                    r.baseline * 1e3, r.median * 1e3, 100.0 * (r.median / r.baseline - 1.0), r.gflops,
+                    status_of(r, threshold));
+        } else {
+            fprintf(f, "| %s | %s | - | %.4f | - | %.2f | %s |\n", matrix.c_str(), kernel.c_str(),
+                    r.median * 1e3, r.gflops, status_of(r, threshold));
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Kokkos::initialize(argc, argv);
+    int exit_code = 0;
+    {
+        std::string baseline_dir = "perf_baselines";
+        std::string summary_path;
+        double threshold = 0.10;
+        int samples = 11;
+        int runs = 3;
+        int retries = 2;
+        bool update = false;
+        for(int a=1; a<argc; a++) {
+            if(!std::strcmp(argv[a], "--baseline-dir") && a + 1 < argc) baseline_dir = argv[++a];
+            else if(!std::strcmp(argv[a], "--threshold") && a + 1 < argc) threshold = std::atof(argv[++a]);
+            else if(!std::strcmp(argv[a], "--summary") && a + 1 < argc) summary_path = argv[++a];
+            else if(!std::strcmp(argv[a], "--samples") && a + 1 < argc) samples = std::max(1, std::atoi(argv[++a]));
+            else if(!std::strcmp(argv[a], "--runs") && a + 1 < argc) runs = std::max(1, std::atoi(argv[++a]));
+            else if(!std::strcmp(argv[a], "--retries") && a + 1 < argc) retries = std::max(0, std::atoi(argv[++a]));
+            else if(!std::strcmp(argv[a], "--update")) update = true;
+            else {
+                printf("[ERROR] Argumen tidak dikenal: %s\n", argv[a]);
+                printf("Usage: %s [--baseline-dir DIR] [--threshold 0.10] [--summary FILE.md] [--samples K] [--runs K] [--retries R] [--update]\n", argv[0]);
+                exit_code = 2;
+            }
+        }
+
+        const std::string host    = host_name();
+        const std::string backend = Kokkos::DefaultExecutionSpace::name();
+        const int threads         = Kokkos::DefaultExecutionSpace().concurrency();
+        mkdir(baseline_dir.c_str(), 0755); // Boleh gagal kalau sudah ada
+        const std::string baseline_path = baseline_dir + "/" + host + "-" + backend + "-" + std::to_string(threads) + ".json";
+
+        printf("=== KOKKOS PERF REGRESSION SUITE ===\n");
+        printf("Host: %s | Backend: %s | Threads: %d | Samples: %d | Runs: %d | Retries: %d\n\n",
+               host.c_str(), backend.c_str(), threads, samples, runs, retries);
+
+        // Ukuran sedang: cukup besar agar keluar dari L2, cukup kecil agar suite selesai < 1 menit
+        std::vector<std::pair<std::string, HostCSR>> matrices;
+        if(exit_code == 0) {
+            matrices.push_back({"stencil_natural", generate_3d_stencil(48, 48, 48, false)});
+            matrices.push_back({"stencil_shuffled", generate_3d_stencil(48, 48, 48, true)});
+            matrices.push_back({"random", generate_random_csr(100000, 8, 24, 12345)});
+            matrices.push_back({"powerlaw", generate_powerlaw_csr(100000, 1.2, 777)});
+        }
+
+        // View ditangkap by value -> data device tetap hidup selama Bench ada (untuk re-measure)
+        std::vector<Bench> benches;
+        double sink = 0.0;
+        for(auto& m : matrices) {
+            const HostCSR& h = m.second;
+            printf("%-18s N = %7d, NNZ = %8d\n", m.first.c_str(), h.num_rows, h.num_nnz);
+            DeviceCSR A = upload(h);
+            Kokkos::View<double*> x("x", h.num_rows);
+            Kokkos::View<double*> y("y", h.num_rows);
+            Kokkos::deep_copy(x, 1.0);
+            const double flops = 2.0 * h.num_nnz * 1e-9;
+
+            benches.push_back({m.first + "/spmv_range", flops, [=]() { spmv_csr(A.row_map, A.col_idx, A.values, x, y); }});
+            benches.push_back({m.first + "/spmv_team", flops, [=]() { spmv_csr_team(A.row_map, A.col_idx, A.values, x, y); }});
+        }
+
+        if(exit_code == 0) {
+            const int n = 1 << 22;
+            Kokkos::View<double*> x("x", n);
+            Kokkos::View<double*> y("y", n);
+            Kokkos::deep_copy(x, 1.0);
+            Kokkos::deep_copy(y, 2.0);
+
+            benches.push_back({"vector_4M/axpby", 3.0 * n * 1e-9, [=]() { axpby(0.5, x, 0.5, y); }});
+            benches.push_back({"vector_4M/dot", 2.0 * n * 1e-9, [=, &sink]() { sink += dot(x, y); }});
+        }
+
+        std::vector<Result> results;
+        const int ITERS = 20;
+        for(const Bench& b : benches) {
+            double t = best_median(b.run, runs, samples, ITERS);
+            results.push_back({b.name, t, b.work / t, -1.0});
+        }
+
+        std::vector<Result> base;
+        bool have_file = exit_code == 0 && load_baseline(baseline_path, base);
+        if(have_file && base.empty() && !update) {
+            printf("\n[ERROR] Baseline %s ada, tapi tidak ada entri yang terbaca (rusak/kosong).\n", baseline_path.c_str());
+            printf("        Perbaiki/hapus file itu, atau jalankan ulang dengan --update.\n");
+            exit_code = 1;
+        }
+
+        if(exit_code == 0) {
+            for(Result& r : results) {
+                for(const Result& b : base) {
+                    if(b.name == r.name) r.baseline = b.median;
+                }
+            }
+
+            // Kernel yang terlihat melambat diukur ulang: regresi asli bertahan, spike noise tidak.
+            for(int attempt=1; attempt<=retries && !update; attempt++) {
+                std::vector<size_t> slow;
+                for(size_t i=0; i<results.size(); i++) {
+                    if(is_regression(results[i], threshold)) slow.push_back(i);
+                }
+                if(slow.empty()) break;
+                printf("Re-measure %d kernel yang melambat (percobaan %d/%d)...\n", (int)slow.size(), attempt, retries);
+                for(size_t i : slow) {
+                    double t = best_median(benches[i].run, runs, samples, ITERS);
+                    printf("  %-28s %.4f ms -> %.4f ms (baseline %.4f ms)\n", results[i].name.c_str(),
+                           results[i].median * 1e3, t * 1e3, results[i].baseline * 1e3);
+                    if(t < results[i].median) {
+                        results[i].median = t;
+                        results[i].gflops = benches[i].work / t;
+                    }
+                }
+            }
+            if(sink == 42.0) printf(" "); // Cegah dot dieliminasi compiler
+
+            int regressions = 0;
+            std::vector<Result> merged = base; // Entri lama dipertahankan, entri baru ditambahkan
+            int added = 0;
+            for(const Result& r : results) {
+                if(r.baseline <= 0.0) {
+                    merged.push_back(r);
+                    added++;
+                }
+                if(is_regression(r, threshold)) regressions++;
+            }
+
+            printf("\n");
+            write_summary(stdout, baseline_path, threshold, results);
+            if(!summary_path.empty()) {
+                FILE* f = std::fopen(summary_path.c_str(), "w");
+                if(f) {
+                    write_summary(f, baseline_path, threshold, results);
+                    std::fclose(f);
+                } else {
+                    printf("[WARNING] Tidak bisa menulis summary %s\n", summary_path.c_str());
+                }
+            }
+
+            printf("\n");
+            const std::vector<Result>& to_write = update ? results : merged;
+            if(update || added > 0) {
+                if(!write_baseline(baseline_path, host, backend, threads, to_write)) {
+                    printf("[ERROR] Tidak bisa menulis baseline %s\n", baseline_path.c_str());
+                    exit_code = 1;
+                } else if(update) {
+                    printf("Baseline diperbarui: %s\n", baseline_path.c_str());
+                } else if(!have_file) {
+                    printf("Baseline dibuat: %s\n", baseline_path.c_str());
+                } else {
+                    printf("Baseline: %d entri baru ditambahkan ke %s\n", added, baseline_path.c_str());
+                }
+            }
+
+            if(update) {
+                printf("PASSED (--update): baseline baru diterima.\n");
+            } else if(regressions > 0) {
+                printf("FAILED: %d kernel lebih lambat dari baseline > %.1f%% (juga setelah %d kali ukur ulang).\n",
+                       regressions, 100.0 * threshold, retries);
+                printf("Jika memang disengaja, jalankan ulang dengan --update untuk menerima angka baru.\n");
+                exit_code = 1;
+            } else if(exit_code == 0) {
+                printf("PASSED: tidak ada kernel yang melambat > %.1f%%.\n", 100.0 * threshold);
+            }
+        }
+    }
+    Kokkos::finalize();
+    return exit_code;
+}
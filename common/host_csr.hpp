@@ -0,0 +1,162 @@
+#pragma once
+#ifdef HAVE_METIS
+#include <metis.h>
+#endif
+#include <vector>
+#include <random>
+#include <algorithm>
+
+// UTILITAS CSR HOST BERSAMA
+// Matriks uji & ordering yang dipakai modul 09, 10, 11, 14 dan 15. Satu definisi -> semua modul
+// membandingkan matriks yang sama, dan konvensi permutasi hanya didefinisikan DI SINI:
+//   perm[old] = new  (baris/kolom lama "old" pindah ke posisi "new")
+// permute_matrix, rcm_ordering dan metis_nodend semuanya memakai/menghasilkan perm[old] = new.
+// (05_reordering punya versi sendiri berbasis idx_t, konvensinya sama: ia memakai iperm METIS.)
+
+struct HostCSR {
+    int num_rows;
+    int num_nnz;
+    std::vector<int> row_map;
+    std::vector<int> col_idx;
+    std::vector<double> values;
+};
+
+// GENERATOR GRID 3D (Natural or Shuffled)
+// Laplacian 7-point: diagonal 6, tetangga -1 -> simetris numerik & SPD.
+inline HostCSR generate_3d_stencil(int nx, int ny, int nz, bool shuffle) {
+    int N = nx * ny * nz;
+    std::vector<std::vector<int>> adj(N);
+
+    auto get_idx = [&](int x, int y, int z) { return x + y*nx + z*nx*ny; };
+
+    for(int z=0; z<nz; z++) {
+        for(int y=0; y<ny; y++) {
+            for(int x=0; x<nx; x++) {
+                int u = get_idx(x,y,z);
+                if(x>0)    adj[u].push_back(get_idx(x-1, y, z));
+                if(x<nx-1) adj[u].push_back(get_idx(x+1, y, z));
+                if(y>0)    adj[u].push_back(get_idx(x, y-1, z));
+                if(y<ny-1) adj[u].push_back(get_idx(x, y+1, z));
+                if(z>0)    adj[u].push_back(get_idx(x, y, z-1));
+                if(z<nz-1) adj[u].push_back(get_idx(x, y, z+1));
+                adj[u].push_back(u); // Include self
+            }
+        }
+    }
+
+    std::vector<int> p(N);
+    for(int i=0; i<N; i++) p[i] = i;
+    if(shuffle) {
+        std::mt19937 rng(12345);
+        std::shuffle(p.begin(), p.end(), rng);
+    }
+    std::vector<int> inv_p(N);
+    for(int i=0; i<N; i++) inv_p[p[i]] = i;
+
+    HostCSR mat;
+    mat.num_rows = N;
+    mat.row_map.push_back(0);
+    for(int i=0; i<N; i++) {
+        int old_u = inv_p[i];
+        std::vector<int> neighbors;
+        for(int old_v : adj[old_u]) neighbors.push_back(p[old_v]);
+        std::sort(neighbors.begin(), neighbors.end());
+        for(int col : neighbors) {
+            mat.col_idx.push_back(col);
+            mat.values.push_back(col == i ? 6.0 : -1.0);
+        }
+        mat.row_map.push_back((int)mat.col_idx.size());
+    }
+    mat.num_nnz = (int)mat.col_idx.size();
+    return mat;
+}
+
+
+// PERMUTASI SIMETRIS P * A * P^T, perm[old] = new
+inline HostCSR permute_matrix(const HostCSR& src, const std::vector<int>& perm) {
+    int N = src.num_rows;
+    std::vector<int> iperm(N);
+    for(int i=0; i<N; i++) iperm[perm[i]] = i;
+
+    HostCSR dest;
+    dest.num_rows = N;
+    dest.num_nnz = src.num_nnz;
+    dest.row_map.push_back(0);
+    for(int new_row=0; new_row<N; new_row++) {
+        int old_row = iperm[new_row];
+        std::vector<std::pair<int, double>> temp;
+        for(int k=src.row_map[old_row]; k<src.row_map[old_row+1]; k++) {
+            temp.push_back({perm[src.col_idx[k]], src.values[k]});
+        }
+        std::sort(temp.begin(), temp.end());
+        for(auto& e : temp) {
+            dest.col_idx.push_back(e.first);
+            dest.values.push_back(e.second);
+        }
+        dest.row_map.push_back((int)dest.col_idx.size());
+    }
+    return dest;
+}
+
+// Reverse Cuthill-McKee: BFS dari node derajat minimum (pseudo-peripheral sederhana),
+// tetangga dikunjungi urut derajat naik, lalu urutan dibalik. Hasil: perm[old] = new.
+inline std::vector<int> rcm_ordering(const HostCSR& mat) {
+    int N = mat.num_rows;
+    std::vector<int> degree(N);
+    for(int i=0; i<N; i++) degree[i] = mat.row_map[i+1] - mat.row_map[i];
+
+    std::vector<int> order;
+    order.reserve(N);
+    std::vector<char> visited(N, 0);
+    std::vector<int> by_degree(N);
+    for(int i=0; i<N; i++) by_degree[i] = i;
+    std::stable_sort(by_degree.begin(), by_degree.end(), [&](int a, int b) { return degree[a] < degree[b]; });
+
+    std::vector<int> nbrs;
+    for(int start : by_degree) { // Loop untuk graf tidak terhubung
+        if(visited[start]) continue;
+        visited[start] = 1;
+        size_t head = order.size();
+        order.push_back(start);
+        while(head < order.size()) {
+            int u = order[head++];
+            nbrs.clear();
+            for(int k=mat.row_map[u]; k<mat.row_map[u+1]; k++) {
+                int v = mat.col_idx[k];
+                if(!visited[v]) {
+                    visited[v] = 1;
+                    nbrs.push_back(v);
+                }
+            }
+            std::sort(nbrs.begin(), nbrs.end(), [&](int a, int b) { return degree[a] < degree[b]; });
+            order.insert(order.end(), nbrs.begin(), nbrs.end());
+        }
+    }
+
+    std::vector<int> perm(N);
+    for(int i=0; i<N; i++) perm[order[N - 1 - i]] = i;
+    return perm;
+}
+
+#ifdef HAVE_METIS
+// Nested dissection METIS. METIS tidak boleh menerima self-loop -> buang diagonal dulu.
+inline bool metis_nodend(const HostCSR& mat, std::vector<int>& perm) {
+    idx_t n = mat.num_rows;
+    std::vector<idx_t> xadj(1, 0);
+    std::vector<idx_t> adjncy;
+    for(int i=0; i<mat.num_rows; i++) {
+        for(int k=mat.row_map[i]; k<mat.row_map[i+1]; k++) {
+            if(mat.col_idx[k] != i) adjncy.push_back(mat.col_idx[k]);
+        }
+        xadj.push_back((idx_t)adjncy.size());
+    }
+    std::vector<idx_t> m_perm(n), m_iperm(n);
+    idx_t options[METIS_NOPTIONS];
+    METIS_SetDefaultOptions(options);
+    // METIS: m_perm[new] = old, m_iperm[old] = new. Konvensi kita perm[old] = new -> pakai m_iperm.
+    int status = METIS_NodeND(&n, xadj.data(), adjncy.data(), NULL, options, m_perm.data(), m_iperm.data());
+    if(status != METIS_OK) return false;
+    perm.assign(m_iperm.begin(), m_iperm.end());
+    return true;
+}
+#endif
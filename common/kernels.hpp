@@ -0,0 +1,38 @@
+#pragma once
+#include <Kokkos_Core.hpp>
+#include "../06_gpu_preparation/spmv_team.hpp" // spmv_csr_team: kernel pelajaran Modul 6, dijaga apa adanya
+
+// KERNEL BERSAMA
+// Kernel yang dipakai modul (05_reordering, 06_gpu_preparation, 13_blas1) DAN dijaga oleh
+// 15_perf_regression. Satu definisi -> perubahan di sini langsung terukur oleh suite regresi.
+// spmv_csr_team tetap tinggal di Modul 6 (dengan komentar pelajarannya) dan di-include di atas.
+
+// CSR SpMV, satu thread per baris: y = A * x
+inline void spmv_csr(Kokkos::View<int*> row_map, Kokkos::View<int*> col_idx, Kokkos::View<double*> values,
+                     Kokkos::View<double*> x, Kokkos::View<double*> y) {
+    const int num_rows = (int)y.extent(0);
+    Kokkos::parallel_for("SpMV_Run", num_rows, KOKKOS_LAMBDA(const int i) {
+        double sum = 0.0;
+        int start = row_map(i);
+        int end   = row_map(i+1);
+        for (int k = start; k < end; k++) {
+            sum += values(k) * x(col_idx(k));
+        }
+        y(i) = sum;
+    });
+}
+
+// y = a*x + b*y
+inline void axpby(double a, Kokkos::View<double*> x, double b, Kokkos::View<double*> y) {
+    Kokkos::parallel_for("BLAS1_axpby", y.extent(0), KOKKOS_LAMBDA(const int i) {
+        y(i) = a * x(i) + b * y(i);
+    });
+}
+
+inline double dot(Kokkos::View<double*> x, Kokkos::View<double*> y) {
+    double result = 0.0;
+    Kokkos::parallel_reduce("BLAS1_dot", x.extent(0), KOKKOS_LAMBDA(const int i, double& lsum) {
+        lsum += x(i) * y(i);
+    }, result);
+    return result;
+}